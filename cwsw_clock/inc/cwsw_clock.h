@@ -18,11 +18,24 @@
 // ----	System Headers --------------------------
 #include <time.h>
 #include <stdint.h>
+#include <stdbool.h>
 
 // ----	Project Headers -------------------------
 #include "cwsw_evqueue_ex.h"	/* tEvQ_Event, et. al. */
 
 // ----	Module Headers --------------------------
+#include "cwsw_clock_cfg.h"		/* build configuration */
+#include "cwsw_tichist.h"		/* tCwswTicHist */
+#include "cwsw_trace.h"			/* CWSW_TRACE() */
+#include "cwsw_fastclock.h"		/* Cwsw_FastClock__NowNs() */
+
+#if (CWSW_CLOCK_MULTICORE)
+#if defined(__cplusplus)
+#include <atomic>
+#else
+#include <stdatomic.h>
+#endif
+#endif
 
 
 #ifdef	__cplusplus
@@ -34,7 +47,35 @@ extern "C" {
 // ----	Constants -------------------------------------------------------------
 // ============================================================================
 
-enum { Cwsw_ClockSvc_TicResolution = 1 };	//!< number of milliseconds per clock tic
+#if ((CWSW_CLOCK_TIC_NS % 1000000) == 0)
+/**	Number of milliseconds per clock tic.
+ *	@deprecated Defined only when a tic is a whole number of milliseconds; use CWSW_CLOCK_TIC_NS
+ *	and the unit conversion macros instead.
+ */
+enum { Cwsw_ClockSvc_TicResolution = CWSW_CLOCK_TIC_NS / 1000000 };
+#endif
+
+enum {
+	kCwswClock_NsPerTic = CWSW_CLOCK_TIC_NS,						//!< nanoseconds per clock tic
+	kCwswClock_MaxIdleTics = 1000000000 / CWSW_CLOCK_TIC_NS,		//!< longest tickless sleep (1 s) when no wakeup is requested
+	kCwswClock_CacheLineSize = 64									//!< alignment that keeps shared clock state off neighboring lines
+};
+
+/**	@name Layout of state shared between threads; see tCwswClockCtx.
+ *	Spelled for C++ as well, so the structures that use them have the same layout in C++ code.
+ */
+//! @{
+#if (CWSW_CLOCK_MULTICORE) && defined(__cplusplus)
+#define CWSW_CLOCK_SHARED(type)	std::atomic<type>
+#define CWSW_CLOCK_LINE			alignas(kCwswClock_CacheLineSize)
+#elif (CWSW_CLOCK_MULTICORE)
+#define CWSW_CLOCK_SHARED(type)	_Atomic(type)
+#define CWSW_CLOCK_LINE			_Alignas(kCwswClock_CacheLineSize)
+#else
+#define CWSW_CLOCK_SHARED(type)	type
+#define CWSW_CLOCK_LINE
+#endif
+//! @}
 
 enum eErrorCodes_ClkSvc {
 	kErr_ClkSvc_NoError = kErr_Lib_NoError,
@@ -50,22 +91,75 @@ enum eErrorCodes_ClkSvc {
 typedef enum eErrorCodes_ClkSvc tClkSvc_ErrorCode;
 
 
-#if defined(_CVI_)
-typedef signed long tCwswClockTics, *pCwswClockTics;
+/**	Clock tics: both points in time (raw tic values) and durations.
+ *	64 bits on every target, so the tic count cannot wrap in the life of any system (at 1 us per
+ *	tic, in about 292,000 years); signed, so time left and elapsed time can be negative.
+ *	Do arithmetic on points in time through Cwsw_ElapsedTimeMs() and Cwsw_TicsAfter(), which work in
+ *	unsigned arithmetic and so are well defined even across a wrap.
+ */
+typedef int64_t tCwswClockTics, *pCwswClockTics;
 
-#else
-/*	building on windows, for windows, we can take advantage of MinGW's
- *	time.h...
+
+/**	Consistent snapshot of clock state; see Cwsw_ClockSvc__GetSnapshot(). */
+typedef struct sCwswClockSnapshot {
+	tCwswClockTics	tic;		/**< Current raw tic. */
+	tCwswClockTics	sinceinit;	/**< Tics since initialization. */
+	tCwswClockTics	maxmissed;	/**< Maximum observed gap between consecutive tics. */
+	uint32_t		hbfailed;	/**< Heartbeats that could not be posted; each is folded into the next. */
+} tCwswClockSnapshot, *ptCwswClockSnapshot;
+
+
+/**	One clock domain.
+ *	Each domain has its own tic, heartbeat, statistics and tickless wakeup, so a process may run
+ *	several (e.g., a fast control-loop clock beside a slow housekeeping clock), each serviced by its
+ *	own thread. Fields published to other threads sit apart from the owner's working set, and, in
+ *	multi-core builds, each group starts on a cache line of its own, so domains driven from
+ *	different threads share no lines.
+ *
+ *	Treat the contents as private to clock services.
  */
-typedef clock_t tCwswClockTics, *pCwswClockTics;
+typedef struct sCwswClockCtx {
+	// published; read by any thread.
+	CWSW_CLOCK_LINE CWSW_CLOCK_SHARED(tCwswClockTics)	thistic;	/**< Current raw tic. */
+	CWSW_CLOCK_SHARED(uint32_t)	ticword;		/**< Low half of `thistic`, on which waiting threads block. */
+
+	// written by waiting threads and pollers.
+	CWSW_CLOCK_LINE CWSW_CLOCK_SHARED(uint32_t)	nwaiters;	/**< Threads blocked in Cwsw_ClockCtx__WaitUntil(). */
+#if (CWSW_CLOCK_POLLFD)
+	CWSW_CLOCK_SHARED(int)		pollfd;			/**< Pollable descriptor; -1 while not open. */
+	CWSW_CLOCK_SHARED(bool)		pollarmed;		/**< Event-fd poller: `polltic` is valid. */
+	CWSW_CLOCK_SHARED(tCwswClockTics)	polltic;	/**< Event-fd poller: tic at which to signal. */
+#endif
 
+	// statistics; written by the owner under the seqlock.
+	CWSW_CLOCK_LINE CWSW_CLOCK_SHARED(uint32_t)	statseq;	/**< Odd while the owner updates the statistics. */
+	CWSW_CLOCK_SHARED(tCwswClockTics)	clockoffset;	/**< Raw tic at initialization. */
+	CWSW_CLOCK_SHARED(tCwswClockTics)	maxct;			/**< Maximum observed gap between consecutive tics. */
+	CWSW_CLOCK_SHARED(uint32_t)	hbfailed;		/**< Heartbeat posts that failed. */
+
+	// owner only.
+	CWSW_CLOCK_LINE ptEvQ_QueueCtrlEx	pEvQX;		/**< Queue for heartbeat events; NULL for none. */
+	tEvQ_Event			heartbeat;
+	tCwswClockTics		hbowed;			/**< Tics covered by heartbeats that failed to post since the last that didn't. */
+	tCwswClockTics		lasttic;
+	tCwswClockTics		thisct;
+	tCwswClockTics		wakeuptic;		/**< Valid only when `wakeuppending` is set. */
+	bool				wakeuppending;
+	pCwswClockTics		pSimClock;		/**< Simulated backend: this domain's simulated clock. */
+	tCwswClockTics		simtic;
+#if (CWSW_CLOCK_HISTOGRAMS)
+	tCwswTicHist		gaphist;		/**< Distribution of the gaps whose maximum is `maxct`. */
 #endif
+} tCwswClockCtx, *ptCwswClockCtx;
 
 
 // ============================================================================
 // ----	Public Variables ------------------------------------------------------
 // ============================================================================
 
+/**	Simulated clock of the default clock domain, for the simulated backend. Other domains each keep
+ *	their own.
+ */
 extern tCwswClockTics simclock;
 
 
@@ -73,15 +167,45 @@ extern tCwswClockTics simclock;
 // ----	Public API ------------------------------------------------------------
 // ============================================================================
 
-#if 0
-#define CLOCK()		clock()
+#if (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_MONOTONIC)
+#define CLOCK()		((tCwswClockTics)(Cwsw_ClockSvc__MonotonicNs() / kCwswClock_NsPerTic))
+#elif (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_CLOCK)
+#define CLOCK()		((tCwswClockTics)(((uint64_t)clock() * (1000000000ULL / CLOCKS_PER_SEC)) / CWSW_CLOCK_TIC_NS))
 #else
-#define CLOCK()		(simclock++)
+#define CLOCK()		(simclock = Cwsw_TicsAfter(simclock, 1), Cwsw_TicsAfter(simclock, -1))
 #endif
 
 
 // ---- Discrete Functions -------------------------------------------------- {
 
+/**	@name Clock domains.
+ *	Each free function below operates on the default domain; these are their counterparts for any
+ *	domain. A domain's init, task and wakeup calls belong to the one thread that drives it; its
+ *	tic, timers and statistics may be read as described for CWSW_CLOCK_MULTICORE.
+ */
+//! @{
+extern void Cwsw_ClockCtx__Init(ptCwswClockCtx pCtx, ptEvQ_QueueCtrlEx pEvQX, int16_t HeartbeatEvId);
+extern tCwswClockTics Cwsw_ClockCtx__Task(ptCwswClockCtx pCtx);
+extern tCwswClockTics Cwsw_ClockCtx__TimerTic(const tCwswClockCtx *pCtx);
+extern tCwswClockTics Cwsw_ClockCtx__Now(const tCwswClockCtx *pCtx);
+extern tClkSvc_ErrorCode Cwsw_ClockCtx__SetTimer(const tCwswClockCtx *pCtx, pCwswClockTics pTimer, tCwswClockTics duration);
+extern tCwswClockTics Cwsw_ClockCtx__GetMaxMissedTics(const tCwswClockCtx *pCtx);
+extern void Cwsw_ClockCtx__GetSnapshot(const tCwswClockCtx *pCtx, ptCwswClockSnapshot pSnap);
+extern void Cwsw_ClockCtx__SetWakeup(ptCwswClockCtx pCtx, tCwswClockTics wakeuptic);
+extern void Cwsw_ClockCtx__Rebase(ptCwswClockCtx pCtx, tCwswClockTics sinceinit);
+extern tCwswClockTics Cwsw_ClockCtx__WaitUntil(ptCwswClockCtx pCtx, tCwswClockTics tic);
+extern tCwswClockTics Cwsw_ClockCtx__WaitHeartbeat(ptCwswClockCtx pCtx);
+#if (CWSW_CLOCK_POLLFD)
+extern int Cwsw_ClockCtx__OpenPollFd(ptCwswClockCtx pCtx);
+extern void Cwsw_ClockCtx__ArmPollFd(ptCwswClockCtx pCtx, tCwswClockTics tic);
+extern void Cwsw_ClockCtx__AckPollFd(ptCwswClockCtx pCtx);
+extern void Cwsw_ClockCtx__ClosePollFd(ptCwswClockCtx pCtx);
+#endif
+#if (CWSW_CLOCK_HISTOGRAMS)
+extern struct sCwswTicHist *Cwsw_ClockCtx__GapHistogram(ptCwswClockCtx pCtx);
+#endif
+//! @}
+
 /**	Initialize Clock Services module.
  *
  *	@param [in]	pEvQX			Reference to an extended event queue.
@@ -101,7 +225,8 @@ extern void Cwsw_ClockSvc__Init(ptEvQ_QueueCtrlEx pEvQX, int16_t HeatbeatEvId);
 /** Task function for clock services.
  *	For systems which have an interrupt-driven timer tic, this function's major purpose is to post
  *	an event for each timer tic. For polled systems, this is the main workhorse for all SW timers
- *	and alarms and it is quite important to poll as quickly as possible.
+ *	and alarms and it is quite important to poll as quickly as possible, unless the build is
+ *	tickless, in which case this function sleeps until the requested wakeup tic.
  *
  *	If a valid OS event queue is referenced (specified in the init call), we post an OS event on
  *	every change; we assume this is a 1 ms resolution, though nothing (as yet) depends on this
@@ -119,6 +244,13 @@ extern tCwswClockTics Cwsw_ClockSvc__Task(void);
  */
 extern tCwswClockTics Cwsw_ClockSvc__TimerTic(void);
 
+/**	Read the clock afresh, rather than the tic latched by the last task call.
+ *	@returns Raw tic value; never earlier than Cwsw_ClockSvc__TimerTic(). With the simulated
+ *			clock, which has no time between task calls, the latched tic.
+ *	@note With the monotonic backend, the reading comes from the fast clock (see cwsw_fastclock.h).
+ */
+extern tCwswClockTics Cwsw_ClockSvc__Now(void);
+
 /**	Set the duration of a timer.
  *	@param[out]	pTimer		Reference to the specified timer.
  *	@param[in]	duration	Duration of the timer in timer tics. Negative values are not possible.
@@ -126,14 +258,32 @@ extern tCwswClockTics Cwsw_ClockSvc__TimerTic(void);
  */
 extern tClkSvc_ErrorCode Cwsw_ClockSvc__SetTimer(pCwswClockTics pTimer, tCwswClockTics duration);
 
-/**	Return the number of ms between start and stop times.
- * 	@note Assumptions:
- * 	- We are assuming there is 1 clock tic per ms; this is what is true for MinGW and so of course
- * 	  that means the whole world does it the same way.
- * 	- The math only works for 2s-complement encodings; 1s-complement and sign-magnitude will need to
- * 	  find another way.
+/**	Return the number of tics between start and stop times.
+ *	Negative if `stop` precedes `start`. The difference is taken in unsigned arithmetic, which is
+ *	defined to wrap, so the result is correct across a rollover of the tic count.
+ *	@note Despite the name, the result is in tics; see CWSW_CLOCK_TIC_NS.
  */
-#define Cwsw_ElapsedTimeMs(start, stop)	(tCwswClockTics)(stop - start)
+#define Cwsw_ElapsedTimeMs(start, stop)	((tCwswClockTics)((uint64_t)(stop) - (uint64_t)(start)))
+
+/**	Return the point in time a given number of tics after (or, for negative `tics`, before) `start`.
+ *	The sum is taken in unsigned arithmetic, for the same reason as Cwsw_ElapsedTimeMs().
+ */
+#define Cwsw_TicsAfter(start, tics)		((tCwswClockTics)((uint64_t)(start) + (uint64_t)(tics)))
+
+/**	@name Unit conversion.
+ *	Convert real-time durations to tics at compile time, at whatever resolution CWSW_CLOCK_TIC_NS
+ *	selects. Partial tics round up, so a timer never matures early, and no nonzero duration
+ *	becomes 0 tics. Arguments are evaluated once, and may be any integer constant expression.
+ */
+//! @{
+#define CWSW_CLOCK_NS(ns)		((tCwswClockTics)(((uint64_t)(ns) + (CWSW_CLOCK_TIC_NS - 1)) / CWSW_CLOCK_TIC_NS))
+#define CWSW_CLOCK_US(us)		CWSW_CLOCK_NS((uint64_t)(us) * 1000ULL)
+#define CWSW_CLOCK_MS(ms)		CWSW_CLOCK_NS((uint64_t)(ms) * 1000000ULL)
+#define CWSW_CLOCK_S(s)			CWSW_CLOCK_NS((uint64_t)(s) * 1000000000ULL)
+//! @}
+
+/**	Convert tics to nanoseconds. */
+#define CWSW_CLOCK_TICS_TO_NS(tics)	((uint64_t)(tics) * CWSW_CLOCK_TIC_NS)
 
 /**	Get the time left in a specified timer.
  *
@@ -152,6 +302,80 @@ extern tClkSvc_ErrorCode Cwsw_ClockSvc__SetTimer(pCwswClockTics pTimer, tCwswClo
  */
 extern tCwswClockTics Cwsw_ClockSvc__GetMaxMissedTics(void);
 
+/**	Take a consistent snapshot of the clock's tic and statistics. */
+extern void Cwsw_ClockSvc__GetSnapshot(ptCwswClockSnapshot pSnap);
+
+#if (CWSW_CLOCK_HISTOGRAMS)
+/**	Histogram of the gaps, in tics, between consecutive tics observed by the task.
+ *	Summarize it with Cwsw_TicHist__Snapshot(); see cwsw_tichist.h.
+ */
+extern struct sCwswTicHist *Cwsw_ClockSvc__GapHistogram(void);
+#endif
+
+#if (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_MONOTONIC)
+/**	Read the monotonic clock.
+ *	@returns Nanoseconds on the POSIX `CLOCK_MONOTONIC` timeline.
+ */
+extern uint64_t Cwsw_ClockSvc__MonotonicNs(void);
+#endif
+
+/**	Request that the next call to Cwsw_ClockSvc__Task() return no later than the specified tic.
+ *	In tickless builds, the task sleeps until this tic (or, if none was requested, for at most
+ *	kCwswClock_MaxIdleTics). The request is consumed by that call. Typically, the caller passes the
+ *	earliest alarm deadline; see Cwsw_SwAlarmSched__NextDeadline(). In other builds, the request has
+ *	no effect.
+ *
+ *	@param [in]	wakeuptic	Raw clock tic, as used by timers.
+ */
+extern void Cwsw_ClockSvc__SetWakeup(tCwswClockTics wakeuptic);
+
+/**	Credit the clock with tics counted before a restart.
+ *	Adds `sinceinit` to the count of tics since initialization reported by Cwsw_ClockSvc__Task() and
+ *	the snapshot, so a process restored from a snapshot (see cwsw_alarmsnap.h) carries on counting
+ *	where it left off. Call after Cwsw_ClockSvc__Init(); raw tics are not affected.
+ *
+ *	@param [in]	sinceinit	Tics since initialization, as saved before the restart.
+ */
+extern void Cwsw_ClockSvc__Rebase(tCwswClockTics sinceinit);
+
+/**	Block the calling thread until the clock reaches the specified tic.
+ *	In single-core builds, the caller is the thread that drives the clock, so this runs the task
+ *	until the tic is reached, sleeping between tics with the monotonic backend. In multi-core
+ *	builds, it is for the other threads: they sleep (on Linux, on a futex) until the task publishes
+ *	the tic. With the monotonic backend they also wake when the tic's time comes, so a late task
+ *	thread doesn't hold them up.
+ *
+ *	@param [in]	tic		Raw clock tic, as used by timers.
+ *	@returns Current raw tic. With the monotonic backend, in multi-core builds, it may trail `tic`
+ *			by the task's lag.
+ */
+extern tCwswClockTics Cwsw_ClockSvc__WaitUntil(tCwswClockTics tic);
+
+/**	Block the calling thread until the next tic; see Cwsw_ClockSvc__WaitUntil(). */
+extern tCwswClockTics Cwsw_ClockSvc__WaitHeartbeat(void);
+
+#if (CWSW_CLOCK_POLLFD)
+/**	@name Pollable clock file descriptor.
+ *	Cwsw_ClockSvc__OpenPollFd() returns a descriptor (opened on first use) that can be added to an
+ *	`epoll` set for input. Cwsw_ClockSvc__ArmPollFd() makes it readable once the given tic arrives;
+ *	arming again replaces the previous tic. After it has become readable, call
+ *	Cwsw_ClockSvc__AckPollFd() before arming it again.
+ *
+ *	With the monotonic backend, this is a `timerfd` on the tic's absolute time, so it fires even
+ *	if no thread is running the task. With the other backends, it is an `eventfd` that the task
+ *	signals, so it is useful only to threads other than the one that drives the clock.
+ *
+ *	The descriptor is non-blocking and close-on-exec. Cwsw_ClockSvc__OpenPollFd() returns -1 if it
+ *	cannot be created.
+ */
+//! @{
+extern int Cwsw_ClockSvc__OpenPollFd(void);
+extern void Cwsw_ClockSvc__ArmPollFd(tCwswClockTics tic);
+extern void Cwsw_ClockSvc__AckPollFd(void);
+extern void Cwsw_ClockSvc__ClosePollFd(void);
+//! @}
+#endif
+
 // ---- /Discrete Functions ------------------------------------------------- }
 
 // ---- Targets for Get/Set APIs -------------------------------------------- {
@@ -0,0 +1,136 @@
+/** @file
+ *	@brief	CWSW Clock Module: build configuration.
+ *
+ *	Each option has a default here, and may be overridden in projcfg.h or on the compiler command
+ *	line. Kept apart from cwsw_clock.h so that modules needing only the configuration (e.g., the
+ *	tic histograms, which the clock itself uses) don't depend on the whole clock API.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef CWSW_CLOCK_CFG_H
+#define CWSW_CLOCK_CFG_H
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/**	@name Clock backends.
+ *	Select the source of raw clock tics by defining CWSW_CLOCK_BACKEND (in projcfg.h, or on the
+ *	compiler command line) to one of these values.
+ *	- Simulated: the clock advances one tic per call to Cwsw_ClockSvc__Task().
+ *	- Process clock: `clock()`. Note this measures processor time, not elapsed time.
+ *	- Monotonic: POSIX `CLOCK_MONOTONIC`, read at nanosecond precision and scaled to tics.
+ */
+//! @{
+#define CWSW_CLOCK_BACKEND_SIM			0
+#define CWSW_CLOCK_BACKEND_CLOCK		1
+#define CWSW_CLOCK_BACKEND_MONOTONIC	2
+//! @}
+
+#if !defined(CWSW_CLOCK_BACKEND)
+#define CWSW_CLOCK_BACKEND				CWSW_CLOCK_BACKEND_SIM
+#endif
+
+/**	Tickless operation.
+ *	When nonzero, Cwsw_ClockSvc__Task() puts the calling thread to sleep until the wakeup tic
+ *	requested via Cwsw_ClockSvc__SetWakeup(), rather than returning immediately to be polled again.
+ *	Requires the monotonic backend.
+ */
+#if !defined(CWSW_CLOCK_TICKLESS)
+#define CWSW_CLOCK_TICKLESS				0
+#endif
+
+#if (CWSW_CLOCK_TICKLESS) && (CWSW_CLOCK_BACKEND != CWSW_CLOCK_BACKEND_MONOTONIC)
+#error "Tickless clock services require the monotonic clock backend."
+#endif
+
+/**	Coalesced heartbeat.
+ *	Cwsw_ClockSvc__Task() posts at most one heartbeat per call. By default, the heartbeat's event
+ *	data is the current raw tic; when this is nonzero, it is instead the number of tics elapsed since
+ *	the previous heartbeat posted, so a consumer that only needs to "catch up" need not infer the gap,
+ *	even across heartbeats lost to a full queue.
+ */
+#if !defined(CWSW_CLOCK_COALESCED_HEARTBEAT)
+#define CWSW_CLOCK_COALESCED_HEARTBEAT	0
+#endif
+
+/**	Multi-core operation.
+ *	When nonzero, one thread runs Cwsw_ClockSvc__Task() and publishes each new tic with C11
+ *	atomics; any number of other threads may call Cwsw_ClockSvc__TimerTic(),
+ *	Cwsw_ClockSvc__SetTimer(), Get(Cwsw_Clock, ...), Cwsw_ClockSvc__GetMaxMissedTics() and
+ *	Cwsw_ClockSvc__GetSnapshot() concurrently. All but the last are wait-free. Init, the task,
+ *	Cwsw_ClockSvc__SetWakeup() and the simulated clock (`simclock`) remain the province of the one
+ *	thread.
+ */
+#if !defined(CWSW_CLOCK_MULTICORE)
+#define CWSW_CLOCK_MULTICORE			0
+#endif
+
+/**	Pollable clock file descriptor (Linux hosts).
+ *	When nonzero, a clock domain can hand out a file descriptor that becomes readable when a chosen
+ *	tic arrives, so clock services and SW alarms can join an existing `epoll` (or `poll`) loop. On
+ *	by default wherever the host is Linux.
+ */
+#if !defined(CWSW_CLOCK_POLLFD)
+#if defined(__linux__)
+#define CWSW_CLOCK_POLLFD				1
+#else
+#define CWSW_CLOCK_POLLFD				0
+#endif
+#endif
+
+#if (CWSW_CLOCK_POLLFD) && !defined(__linux__)
+#error "The pollable clock file descriptor requires a Linux host."
+#endif
+
+/**	Latency and jitter histograms (see cwsw_tichist.h).
+ *	When nonzero, clock services keep a histogram of tic-to-tic gaps, and SW alarms keep histograms
+ *	of alarm lateness and event-post latency. When zero, all of it compiles out.
+ */
+#if !defined(CWSW_CLOCK_HISTOGRAMS)
+#define CWSW_CLOCK_HISTOGRAMS			0
+#endif
+
+/**	Trace recorder (see cwsw_trace.h).
+ *	When nonzero, clock services and SW alarms record their activity to the calling thread's trace
+ *	ring, if it has one. When zero, all of it compiles out.
+ */
+#if !defined(CWSW_CLOCK_TRACE)
+#define CWSW_CLOCK_TRACE				0
+#endif
+
+/**	TSC fast clock (see cwsw_fastclock.h).
+ *	When nonzero, fresh readings of the clock come from the CPU's invariant TSC, calibrated against
+ *	`CLOCK_MONOTONIC`, wherever the CPU has one. On by default with the monotonic backend on x86-64
+ *	Linux hosts; elsewhere, fresh readings come from clock_gettime().
+ */
+#if !defined(CWSW_CLOCK_TSC)
+#if (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_MONOTONIC) && defined(__x86_64__) && defined(__linux__) && defined(__GNUC__)
+#define CWSW_CLOCK_TSC					1
+#else
+#define CWSW_CLOCK_TSC					0
+#endif
+#endif
+
+#if (CWSW_CLOCK_TSC) && ((CWSW_CLOCK_BACKEND != CWSW_CLOCK_BACKEND_MONOTONIC) || !defined(__x86_64__) || !defined(__GNUC__))
+#error "The TSC fast clock requires the monotonic clock backend on an x86-64 host, and a GNU-compatible compiler."
+#endif
+
+/**	Length of one clock tic, in nanoseconds.
+ *	Any whole number of nanoseconds up to one second; e.g., 100000 runs the heartbeat at 100 us.
+ *	Durations given in real-time units are converted with the CWSW_CLOCK_US() family of macros.
+ */
+#if !defined(CWSW_CLOCK_TIC_NS)
+#define CWSW_CLOCK_TIC_NS				1000000
+#endif
+
+#if (CWSW_CLOCK_TIC_NS < 1) || (CWSW_CLOCK_TIC_NS > 1000000000)
+#error "CWSW_CLOCK_TIC_NS must be between 1 ns and 1 s."
+#endif
+
+#endif /* CWSW_CLOCK_CFG_H */
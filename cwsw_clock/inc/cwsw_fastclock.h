@@ -0,0 +1,109 @@
+/** @file
+ *	@brief	CWSW Fast Clock: fresh, fine-grained timestamps at the cost of a few nanoseconds.
+ *
+ *	Cwsw_ClockSvc__TimerTic() returns the tic latched by the last task call, so it is only as fresh,
+ *	and as fine, as the poll loop. The fast clock reads time afresh on every call, in nanoseconds on
+ *	the `CLOCK_MONOTONIC` timeline, so its readings can be set against raw tics and deadlines.
+ *
+ *	On x86-64 Linux hosts with an invariant TSC (one that ticks at a constant rate in every power
+ *	state), a reading is one `rdtscp` and a multiply: the TSC is calibrated against
+ *	`CLOCK_MONOTONIC` when the default clock domain is initialized, and re-synchronized about once a
+ *	second by its task, which keeps the two within a few hundred nanoseconds. Elsewhere, or should
+ *	the TSC prove unsteady, readings come from `clock_gettime()`, itself served by the vDSO without
+ *	a system call on Linux.
+ *
+ *	Available with the monotonic clock backend.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef CWSW_FASTCLOCK_H
+#define CWSW_FASTCLOCK_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdint.h>
+#include <stdbool.h>
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "cwsw_clock_cfg.h"	/* CWSW_CLOCK_BACKEND, CWSW_CLOCK_TSC */
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum eCwswFastClockTiming {
+	kCwswFastClock_CalibrateNs	= 2000000,		//!< Length of the initial calibration, in ns.
+	kCwswFastClock_ResyncNs		= 1000000000,	//!< Interval between re-synchronizations, in ns.
+	kCwswFastClock_MaxSkewPpm	= 1000			//!< Largest change of rate accepted at a resync; beyond it, the TSC is abandoned.
+};
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/**	State of the fast clock, for diagnostics. */
+typedef struct sCwswFastClockInfo {
+	bool		tsc;		/**< Readings come from the TSC; otherwise from clock_gettime(). */
+	uint64_t	tschz;		/**< Calibrated TSC rate, in Hz; 0 if not in use. */
+	uint32_t	resyncs;	/**< Re-synchronizations since initialization. */
+	int64_t		lastadjns;	/**< Correction applied at the last resync: monotonic time less TSC time. */
+} tCwswFastClockInfo, *ptCwswFastClockInfo;
+
+
+// ============================================================================
+// ----	Public Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+#if (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_MONOTONIC)
+
+// ---- Discrete Functions -------------------------------------------------- {
+
+extern void Cwsw_FastClock__Init(void);
+extern uint64_t Cwsw_FastClock__NowNs(void);
+extern void Cwsw_FastClock__Resync(void);
+extern void Cwsw_FastClock__Poll(uint64_t nowns);
+extern void Cwsw_FastClock__GetInfo(ptCwswFastClockInfo pInfo);
+
+// ---- /Discrete Functions ------------------------------------------------- }
+
+#endif
+
+// ---- Targets for Get/Set APIs -------------------------------------------- {
+
+/** "Chapter Designator" for Get/Set API.
+ *	Intentionally unused symbol, designed to get you to the correct starting
+ *	point, when you want to find macros for the Get/Set API; simply highlight
+ *	the Module argument in your IDE (e.g, Eclipse, NetBeans, etc.), and select
+ *	Go To Definition.
+ */
+enum { Cwsw_FastClock };	/* Component ID for the Fast Clock */
+
+// ---- /Targets for Get/Set APIs ------------------------------------------- }
+
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* CWSW_FASTCLOCK_H */
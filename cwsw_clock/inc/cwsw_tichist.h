@@ -0,0 +1,123 @@
+/** @file
+ *	@brief	CWSW Tic Histograms: low-overhead latency and jitter instrumentation.
+ *
+ *	Log-linear ("HDR-style") histograms: each power-of-2 range of values is split into
+ *	kTicHist_SubBuckets equal buckets, so every recorded value is kept to within about 6%, from 0
+ *	up to 2^32-1, in a fixed, modest amount of memory. Recording is one bucket increment plus a max
+ *	update; both are lock-free atomics in multi-core builds.
+ *
+ *	Enabled with CWSW_CLOCK_HISTOGRAMS. When disabled, the recording macro expands to nothing, and
+ *	neither the type nor the API exists.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef CWSW_TICHIST_H
+#define CWSW_TICHIST_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdint.h>
+#include <stdbool.h>
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "cwsw_clock_cfg.h"	/* CWSW_CLOCK_HISTOGRAMS, CWSW_CLOCK_MULTICORE */
+
+#if (CWSW_CLOCK_HISTOGRAMS) && (CWSW_CLOCK_MULTICORE)
+#if defined(__cplusplus)
+#include <atomic>
+#else
+#include <stdatomic.h>
+#endif
+#endif
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum eTicHistGeometry {
+	kTicHist_SubBucketBits	= 4,
+	kTicHist_SubBuckets		= (1 << kTicHist_SubBucketBits),
+	kTicHist_Buckets		= (32 - kTicHist_SubBucketBits + 1) * kTicHist_SubBuckets	//!< covers all of uint32_t
+};
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+#if (CWSW_CLOCK_HISTOGRAMS)
+
+#if (CWSW_CLOCK_MULTICORE) && defined(__cplusplus)
+typedef std::atomic<uint32_t>	tTicHistCounter;
+#elif (CWSW_CLOCK_MULTICORE)
+typedef _Atomic uint32_t	tTicHistCounter;
+#else
+typedef uint32_t			tTicHistCounter;
+#endif
+
+/**	One histogram. Zero-initialized storage is a valid, empty histogram. */
+typedef struct sCwswTicHist {
+	tTicHistCounter		counts[kTicHist_Buckets];
+	tTicHistCounter		max;
+} tCwswTicHist, *ptCwswTicHist;
+
+/**	Summary of a histogram, in the units recorded. */
+typedef struct sCwswTicHistSnapshot {
+	uint32_t	count;
+	uint32_t	p50;
+	uint32_t	p99;
+	uint32_t	p999;
+	uint32_t	max;
+} tCwswTicHistSnapshot, *ptCwswTicHistSnapshot;
+
+#endif
+
+
+// ============================================================================
+// ----	Public Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+#if (CWSW_CLOCK_HISTOGRAMS)
+
+// ---- Discrete Functions -------------------------------------------------- {
+
+extern void Cwsw_TicHist__Record(ptCwswTicHist pHist, uint32_t value);
+extern void Cwsw_TicHist__Snapshot(ptCwswTicHist pHist, ptCwswTicHistSnapshot pSnap, bool reset);
+
+// ---- /Discrete Functions ------------------------------------------------- }
+
+/**	Record one value; compiles to nothing when histograms are disabled. */
+#define CWSW_TICHIST_RECORD(hist, value)	Cwsw_TicHist__Record(&(hist), (uint32_t)(value))
+
+#else
+
+#define CWSW_TICHIST_RECORD(hist, value)	((void)0)
+
+#endif
+
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* CWSW_TICHIST_H */
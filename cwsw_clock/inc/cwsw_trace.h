@@ -0,0 +1,161 @@
+/** @file
+ *	@brief	CWSW Trace Recorder: a flight recorder of tic and alarm activity.
+ *
+ *	Each thread that records owns a ring of fixed-size binary records, in storage supplied by the
+ *	caller. Recording is a handful of stores into the calling thread's own ring, with no locks and
+ *	no shared cache lines, so the recorder can be left running in production; the ring keeps the
+ *	most recent records, overwriting the oldest. When something goes wrong (a latency spike, say),
+ *	any thread can write out what the rings hold as Chrome trace-event JSON, which both
+ *	`chrome://tracing` and the Perfetto UI open directly.
+ *
+ *	Clock services record each new tic, and SW alarms record arming, maturing (on time or late),
+ *	cancellation, and the outcome of each event post. Applications may add records of their own,
+ *	from kCwswTrace_User up.
+ *
+ *	Enabled with CWSW_CLOCK_TRACE. When disabled, the recording macro expands to nothing, and
+ *	neither the types nor the API exist.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef CWSW_TRACE_H
+#define CWSW_TRACE_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "cwsw_clock_cfg.h"	/* CWSW_CLOCK_TRACE, CWSW_CLOCK_MULTICORE */
+
+#if (CWSW_CLOCK_TRACE) && (CWSW_CLOCK_MULTICORE)
+#if defined(__cplusplus)
+#include <atomic>
+#else
+#include <stdatomic.h>
+#endif
+#endif
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/**	Kinds of trace record, and the meaning of each record's `id` and `arg`. */
+enum eCwswTraceType {
+	kCwswTrace_None = 0,
+	kCwswTrace_Tic,				//!< New clock tic. arg: tics since the previous tic.
+	kCwswTrace_AlarmArmed,		//!< Alarm registered with a scheduler. id: event; arg: tics to its deadline.
+	kCwswTrace_AlarmFired,		//!< Alarm matured on its deadline. id: event.
+	kCwswTrace_AlarmLate,		//!< Alarm matured after its deadline. id: event; arg: tics late.
+	kCwswTrace_AlarmCancelled,	//!< Registered alarm cancelled. id: event.
+	kCwswTrace_EvPosted,		//!< Alarm event posted. id: event.
+	kCwswTrace_EvPostFailed,	//!< Alarm event post failed. id: event; arg: event queue error code.
+	kCwswTrace_EvDeferred,		//!< Alarm event held in an overflow buffer. id: event; arg: events now held.
+	kCwswTrace_EvDropped,		//!< Alarm event lost to backpressure. id: event.
+	kCwswTrace_User = 64		//!< First of the application's own record types.
+};
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+#if (CWSW_CLOCK_TRACE)
+
+#if (CWSW_CLOCK_MULTICORE) && defined(__cplusplus)
+typedef std::atomic<uint64_t>	tCwswTraceIndex;
+#elif (CWSW_CLOCK_MULTICORE)
+typedef _Atomic uint64_t	tCwswTraceIndex;
+#else
+typedef uint64_t			tCwswTraceIndex;
+#endif
+
+/**	One trace record; 16 bytes, so four share a cache line. */
+typedef struct sCwswTraceRec {
+	uint64_t	ns;			/**< Timestamp, in nanoseconds. */
+	uint32_t	arg;		/**< Type-specific value; see eCwswTraceType. */
+	uint16_t	id;			/**< Type-specific identifier; for alarms, the event ID. */
+	uint8_t		type;		/**< One of eCwswTraceType. */
+	uint8_t		rsvd;
+} tCwswTraceRec, *ptCwswTraceRec;
+
+/**	One thread's ring of records.
+ *	Only the owning thread writes; any thread may read it through the API. Treat the contents as
+ *	private to the recorder.
+ */
+typedef struct sCwswTraceRing {
+	tCwswTraceIndex			head;		/**< Count of records ever written; the next goes at `head & mask`. */
+	uint32_t				mask;		/**< Capacity - 1. */
+	ptCwswTraceRec			pRecs;
+	const char				*name;		/**< Thread name shown by trace viewers; may be NULL. */
+	uint32_t				tid;		/**< Thread number shown by trace viewers; assigned at attach. */
+	struct sCwswTraceRing	*pNext;		/**< Next ring attached, in the recorder's list of rings. */
+} tCwswTraceRing, *ptCwswTraceRing;
+
+#endif
+
+
+// ============================================================================
+// ----	Public Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+#if (CWSW_CLOCK_TRACE)
+
+// ---- Discrete Functions -------------------------------------------------- {
+
+extern bool Cwsw_Trace__Attach(ptCwswTraceRing pRing, ptCwswTraceRec pRecs, uint32_t capacity, const char *name);
+extern void Cwsw_Trace__Detach(void);
+extern void Cwsw_Trace__Record(uint8_t type, uint16_t id, uint32_t arg);
+extern uint32_t Cwsw_Trace__Collect(const tCwswTraceRing *pRing, ptCwswTraceRec pOut, uint32_t nmax);
+extern int Cwsw_Trace__WriteJson(FILE *fp, ptCwswTraceRec pScratch, uint32_t nscratch);
+
+// ---- /Discrete Functions ------------------------------------------------- }
+
+/**	Record one event on the calling thread's ring; compiles to nothing when tracing is disabled. */
+#define CWSW_TRACE(type, id, arg)	Cwsw_Trace__Record((uint8_t)(type), (uint16_t)(id), (uint32_t)(arg))
+
+#else
+
+#define CWSW_TRACE(type, id, arg)	((void)0)
+
+#endif
+
+// ---- Targets for Get/Set APIs -------------------------------------------- {
+
+/** "Chapter Designator" for Get/Set API.
+ *	Intentionally unused symbol, designed to get you to the correct starting
+ *	point, when you want to find macros for the Get/Set API; simply highlight
+ *	the Module argument in your IDE (e.g, Eclipse, NetBeans, etc.), and select
+ *	Go To Definition.
+ */
+enum { Cwsw_Trace };	/* Component ID for the Trace Recorder */
+
+// ---- /Targets for Get/Set APIs ------------------------------------------- }
+
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* CWSW_TRACE_H */
@@ -4,6 +4,9 @@
  *	Description:
  *	Requires support of a hardware time module.
  *
+ *	All state of a clock domain lives in its tCwswClockCtx; the free functions operate on the
+ *	default domain.
+ *
  *	\copyright
  *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
  *
@@ -16,18 +19,62 @@
 // ============================================================================
 
 // ----	System Headers --------------------------
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#if defined(__linux__)
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
 
 // ----	Project Headers -------------------------
 #include "projcfg.h"
 
 // ----	Module Headers --------------------------
 #include "cwsw_clock.h"
+#include "cwsw_tichist.h"
+#include "cwsw_trace.h"
+
+#if (CWSW_CLOCK_POLLFD)
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#endif
 
 
 // ============================================================================
 // ----	Constants -------------------------------------------------------------
 // ============================================================================
 
+/**	@name Access to state shared with other threads.
+ *	In multi-core builds, the current tic is published by the thread running the task with a
+ *	release store, and read by any thread with an acquire load. The statistics are guarded by a
+ *	seqlock, so a snapshot is consistent without readers ever writing shared state. In single-core
+ *	builds, these collapse to plain accesses.
+ */
+//! @{
+#if (CWSW_CLOCK_MULTICORE)
+#define CLK_LOAD(var)			atomic_load_explicit(&(var), memory_order_acquire)
+#define CLK_STORE(var, val)		atomic_store_explicit(&(var), (val), memory_order_release)
+#define CLK_PEEK(var)			atomic_load_explicit(&(var), memory_order_relaxed)
+#define CLK_POKE(var, val)		atomic_store_explicit(&(var), (val), memory_order_relaxed)
+#else
+#define CLK_LOAD(var)			(var)
+#define CLK_STORE(var, val)		((var) = (val))
+#define CLK_PEEK(var)			(var)
+#define CLK_POKE(var, val)		((var) = (val))
+#endif
+//! @}
+
+/**	Threads waiting on another thread's task sleep on a futex where there is one. */
+#if (CWSW_CLOCK_MULTICORE) && defined(__linux__)
+#define CLK_FUTEX	1
+#else
+#define CLK_FUTEX	0
+#endif
+
 // ============================================================================
 // ----	Type Definitions ------------------------------------------------------
 // ============================================================================
@@ -43,86 +90,623 @@ tCwswClockTics simclock = 0;
 // ----	Module-level Variables ------------------------------------------------
 // ============================================================================
 
-static ptEvQ_QueueCtrlEx	pOsEvQX = NULL;
-static tEvQ_Event			ev_os_heartbeat = {0};
+/** The default clock domain, on which the free functions operate. */
+static tCwswClockCtx	defaultclock = {
+	.pSimClock = &simclock,
+#if (CWSW_CLOCK_POLLFD)
+	.pollfd = -1,
+#endif
+};
+
+
+// ============================================================================
+// ----	Private Prototypes ----------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/**	Read a domain's raw clock. */
+static tCwswClockTics
+clock_read(ptCwswClockCtx pCtx)
+{
+#if (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_SIM)
+	tCwswClockTics now = *pCtx->pSimClock;
+
+	*pCtx->pSimClock = Cwsw_TicsAfter(now, 1);	// wraps, as a hardware counter would
+	return now;
+#else
+	(void)pCtx;
+	return CLOCK();
+#endif
+}
+
+/**	Open / close an update of the statistics. */
+//! @{
+static void
+clock_stats_begin(ptCwswClockCtx pCtx)
+{
+#if (CWSW_CLOCK_MULTICORE)
+	(void)atomic_fetch_add_explicit(&pCtx->statseq, 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+#else
+	(void)pCtx;
+#endif
+}
+
+static void
+clock_stats_end(ptCwswClockCtx pCtx)
+{
+#if (CWSW_CLOCK_MULTICORE)
+	(void)atomic_fetch_add_explicit(&pCtx->statseq, 1, memory_order_release);
+#else
+	(void)pCtx;
+#endif
+}
+//! @}
 
-/** Offset between value returned by clock(), and the number of tics since initialization.
+#if (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_MONOTONIC)
+/**	Time at which a raw tic begins, on the `CLOCK_MONOTONIC` timeline. */
+static struct timespec
+clock_tic_time(tCwswClockTics tic)
+{
+	struct timespec ts;
+	uint64_t ns = CWSW_CLOCK_TICS_TO_NS(tic);
+
+	ts.tv_sec = (time_t)(ns / 1000000000ULL);
+	ts.tv_nsec = (long)(ns % 1000000000ULL);
+	return ts;
+}
+#endif
+
+#if (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_MONOTONIC) && ((CWSW_CLOCK_TICKLESS) || !(CWSW_CLOCK_MULTICORE))
+/**	Sleep until the specified tic.
+ *	An absolute deadline is used, so time spent between the decision and the sleep is not lost.
+ *	A signal may cut the sleep short; that is harmless, as the caller simply polls again.
  */
-static tCwswClockTics	clockoffset = 0;
+static void
+clock_sleep_until(tCwswClockTics tic)
+{
+	struct timespec ts = clock_tic_time(tic);
+	(void)clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+}
+#endif
 
-/** Current timer tic. */
-static tCwswClockTics	thistic;
+#if (CWSW_CLOCK_TICKLESS)
+/**	Sleep until the requested wakeup tic, or for the maximum idle time if there is no request. */
+static void
+clock_sleep_until_wakeup(ptCwswClockCtx pCtx)
+{
+	tCwswClockTics now = CLK_PEEK(pCtx->thistic);
+	tCwswClockTics until = pCtx->wakeuppending ? pCtx->wakeuptic : Cwsw_TicsAfter(now, kCwswClock_MaxIdleTics);
 
-/** Maximum observed "missed" timer tics.
- *	For an interrupt-based system, one would expect that this should always be "1"; for a polled
- *	system, higher values may indicate lower system stability or responsiveness.
+	pCtx->wakeuppending = false;
+	if(Cwsw_ElapsedTimeMs(now, until) <= 0)	{ return; }
+	clock_sleep_until(until);
+}
+#endif
+
+/**	Let waiting threads and pollers know about a new tic. Owner only.
+ *	The futex is woken only while some thread is blocked on it, so an unwatched clock makes no
+ *	system calls. The store of `ticword` and the load of `nwaiters` are sequentially consistent,
+ *	pairing with the waiter's registration in clock_block(), so a waiter either is woken or sees
+ *	the new tic before it sleeps.
  */
-static tCwswClockTics maxct = 0;
+static void
+clock_notify(ptCwswClockCtx pCtx, tCwswClockTics now)
+{
+#if (CWSW_CLOCK_MULTICORE)
+	atomic_store(&pCtx->ticword, (uint32_t)now);
+#if (CLK_FUTEX)
+	if(atomic_load(&pCtx->nwaiters))
+	{
+		(void)syscall(SYS_futex, (uint32_t *)&pCtx->ticword, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+	}
+#endif
+#else
+	pCtx->ticword = (uint32_t)now;
+#endif
 
+#if (CWSW_CLOCK_POLLFD) && (CWSW_CLOCK_BACKEND != CWSW_CLOCK_BACKEND_MONOTONIC)
+	// the event fd is disarmed before it is signaled, so a poller that re-arms it after each
+	// wakeup never misses one, though it may now and then be woken early.
+	if(CLK_LOAD(pCtx->pollarmed) && (Cwsw_ElapsedTimeMs(CLK_PEEK(pCtx->polltic), now) >= 0))
+	{
+		CLK_POKE(pCtx->pollarmed, false);
+		(void)eventfd_write(CLK_PEEK(pCtx->pollfd), 1);
+	}
+#endif
+}
 
-// ============================================================================
-// ----	Private Prototypes ----------------------------------------------------
-// ============================================================================
+#if (CWSW_CLOCK_MULTICORE)
+/**	Block until another thread's task publishes the specified tic, or, with the monotonic backend,
+ *	until that tic's time has come.
+ */
+static void
+clock_block(ptCwswClockCtx pCtx, tCwswClockTics tic)
+{
+	uint32_t word;
+#if (CLK_FUTEX) && (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_MONOTONIC)
+	struct timespec ts = clock_tic_time(tic);
+#endif
+
+	(void)atomic_fetch_add(&pCtx->nwaiters, 1);
+	for(;;)
+	{
+		word = atomic_load(&pCtx->ticword);
+		if(Cwsw_ElapsedTimeMs(CLK_LOAD(pCtx->thistic), tic) <= 0)	{ break; }
+
+#if (CLK_FUTEX) && (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_MONOTONIC)
+		// FUTEX_WAIT_BITSET takes an absolute CLOCK_MONOTONIC timeout.
+		if((syscall(SYS_futex, (uint32_t *)&pCtx->ticword, FUTEX_WAIT_BITSET_PRIVATE, word, &ts, NULL,
+			FUTEX_BITSET_MATCH_ANY) < 0) && (errno == ETIMEDOUT))
+		{
+			break;
+		}
+#elif (CLK_FUTEX)
+		(void)syscall(SYS_futex, (uint32_t *)&pCtx->ticword, FUTEX_WAIT_PRIVATE, word, NULL, NULL, 0);
+#else
+		(void)word;		// no futex on this host; spin.
+#endif
+	}
+	(void)atomic_fetch_sub(&pCtx->nwaiters, 1);
+}
+
+#else
+
+/**	Drive the clock until it reaches the specified tic. */
+static void
+clock_run_until(ptCwswClockCtx pCtx, tCwswClockTics tic)
+{
+	while(Cwsw_ElapsedTimeMs(pCtx->thistic, tic) > 0)
+	{
+#if (CWSW_CLOCK_TICKLESS)
+		Cwsw_ClockCtx__SetWakeup(pCtx, tic);
+#elif (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_MONOTONIC)
+		clock_sleep_until(tic);
+#endif
+		(void)Cwsw_ClockCtx__Task(pCtx);
+	}
+}
+#endif
 
 // ============================================================================
 // ----	Public Functions ------------------------------------------------------
 // ============================================================================
 
-tCwswClockTics
-Cwsw_ClockSvc__TimerTic(void)
+/**	Initialize a clock domain.
+ *	The domain's storage may be anywhere (static, or on the stack of the thread that drives it); in
+ *	multi-core builds, prefer storage of its own, so unrelated data doesn't share its cache lines.
+ *
+ *	@param [out]	pCtx			Domain to initialize.
+ *	@param [in]		pEvQX			Queue for the domain's heartbeat events; NULL for none.
+ *	@param [in]		HeartbeatEvId	Event to post for each new tic.
+ */
+void
+Cwsw_ClockCtx__Init(ptCwswClockCtx pCtx, ptEvQ_QueueCtrlEx pEvQX, int16_t HeartbeatEvId)
 {
-	return thistic;
+	if(!pCtx)		{ return; }
+
+	memset(pCtx, 0, sizeof(*pCtx));
+	pCtx->pSimClock = (pCtx == &defaultclock) ? &simclock : &pCtx->simtic;
+#if (CWSW_CLOCK_POLLFD)
+	pCtx->pollfd = -1;
+#endif
+
+	pCtx->pEvQX = pEvQX;										// remember the address of the OS event queue.
+	pCtx->heartbeat.evId = (tEvQ_EventID)HeartbeatEvId;		// and also remember the event we're to post.
+
+	clock_stats_begin(pCtx);
+	CLK_POKE(pCtx->clockoffset, clock_read(pCtx));
+	clock_stats_end(pCtx);
+
+#if (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_MONOTONIC)
+	if(pCtx == &defaultclock)	{ Cwsw_FastClock__Init(); }
+#endif
 }
 
 
+/**	Task function for a clock domain; see Cwsw_ClockSvc__Task(). */
 tCwswClockTics
-Cwsw_ClockSvc__Task(void)
+Cwsw_ClockCtx__Task(ptCwswClockCtx pCtx)
 {
-	static tCwswClockTics lasttic = 0;
-	static tCwswClockTics thisct;
+	tCwswClockTics now;
+
+	if(!pCtx)		{ return 0; }
 
-	thistic = CLOCK();	// MinGW on Windows has a 1-ms resolution
-	if((thistic) != lasttic)
+#if (CWSW_CLOCK_TICKLESS)
+	clock_sleep_until_wakeup(pCtx);
+#endif
+
+	now = clock_read(pCtx);	// MinGW on Windows has a 1-ms resolution
+	if((now) != pCtx->lasttic)
 	{
-		if(lasttic)
+		clock_stats_begin(pCtx);
+		pCtx->thisct = 1;
+		if(pCtx->lasttic)
 		{
-			thisct = (thistic - lasttic);
-			if(thisct > maxct)	{ maxct = thisct; }
+			pCtx->thisct = Cwsw_ElapsedTimeMs(pCtx->lasttic, now);
+			if(pCtx->thisct > CLK_PEEK(pCtx->maxct))	{ CLK_POKE(pCtx->maxct, pCtx->thisct); }
+			CWSW_TICHIST_RECORD(pCtx->gaphist, pCtx->thisct);
 		}
-		lasttic = thistic;
-		if(pOsEvQX)
+		pCtx->lasttic = now;
+		CLK_STORE(pCtx->thistic, now);
+		clock_stats_end(pCtx);
+		clock_notify(pCtx, now);
+		CWSW_TRACE(kCwswTrace_Tic, 0, pCtx->thisct);
+#if (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_MONOTONIC)
+		if(pCtx == &defaultclock)	{ Cwsw_FastClock__Poll(CWSW_CLOCK_TICS_TO_NS(now)); }
+#endif
+
+		if(pCtx->pEvQX)
 		{
-			ev_os_heartbeat.evData = (uint32_t)thistic;
-			(void)Cwsw_EvQX__PostEvent(pOsEvQX, ev_os_heartbeat);
+			// a heartbeat that can't be posted isn't held; the next one stands in for it.
+			pCtx->hbowed += pCtx->thisct;
+#if (CWSW_CLOCK_COALESCED_HEARTBEAT)
+			pCtx->heartbeat.evData = (uint32_t)pCtx->hbowed;
+#else
+			pCtx->heartbeat.evData = (uint32_t)now;
+#endif
+			if(Cwsw_EvQX__PostEvent(pCtx->pEvQX, pCtx->heartbeat))
+			{
+				clock_stats_begin(pCtx);
+				CLK_POKE(pCtx->hbfailed, CLK_PEEK(pCtx->hbfailed) + 1);
+				clock_stats_end(pCtx);
+			}
+			else
+			{
+				pCtx->hbowed = 0;
+			}
 		}
 	}
-	return thistic - clockoffset;
+	return Cwsw_ElapsedTimeMs(CLK_PEEK(pCtx->clockoffset), now);
 }
 
 
-void
-Cwsw_ClockSvc__Init(ptEvQ_QueueCtrlEx pEvQX, int16_t HeatbeatEvId)
+/**	Current raw tic of a clock domain. */
+tCwswClockTics
+Cwsw_ClockCtx__TimerTic(const tCwswClockCtx *pCtx)
 {
-	pOsEvQX = pEvQX;									// remember the address of the OS event queue.
-	ev_os_heartbeat.evId = (tEvQ_EventID)HeatbeatEvId;	// and also remember the event we're to post.
+	return pCtx ? CLK_LOAD(pCtx->thistic) : 0;
+}
+
 
-	clockoffset = CLOCK();
+/**	Fresh reading of a clock domain's clock; see Cwsw_ClockSvc__Now(). */
+tCwswClockTics
+Cwsw_ClockCtx__Now(const tCwswClockCtx *pCtx)
+{
+	tCwswClockTics latched;
+	tCwswClockTics now;
+
+	if(!pCtx)		{ return 0; }
+
+	latched = CLK_LOAD(pCtx->thistic);
+#if (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_MONOTONIC)
+	now = (tCwswClockTics)(Cwsw_FastClock__NowNs() / kCwswClock_NsPerTic);
+#elif (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_CLOCK)
+	now = CLOCK();
+#else
+	now = latched;
+#endif
+	// the fast clock may trail the monotonic clock by a fraction of a microsecond.
+	return (Cwsw_ElapsedTimeMs(latched, now) < 0) ? latched : now;
 }
 
 
+/**	Set the duration of a timer against a clock domain's tic. */
 tClkSvc_ErrorCode
-Cwsw_ClockSvc__SetTimer(pCwswClockTics pTimer, tCwswClockTics duration)
+Cwsw_ClockCtx__SetTimer(const tCwswClockCtx *pCtx, pCwswClockTics pTimer, tCwswClockTics duration)
 {
-	if(!pTimer)			{ return kerr_ClkSvc_BadParm; }
-	if(duration < 1)	{ return kerr_ClkSvc_BadParm; }
+	if(!pCtx || !pTimer)	{ return kerr_ClkSvc_BadParm; }
+	if(duration < 1)		{ return kerr_ClkSvc_BadParm; }
 
-	*pTimer = thistic + duration;	// raw clock reading, rather than ClockSvc(), 'cuzza
+	*pTimer = Cwsw_TicsAfter(CLK_LOAD(pCtx->thistic), duration);	// raw clock reading, rather than ClockSvc(), 'cuzza
 	return kErr_ClkSvc_NoError;
 }
 
 
+/**	Maximum number of missed task iterations of a clock domain. */
+tCwswClockTics
+Cwsw_ClockCtx__GetMaxMissedTics(const tCwswClockCtx *pCtx)
+{
+	return pCtx ? CLK_LOAD(pCtx->maxct) : 0;
+}
+
+
+/**	Take a consistent snapshot of a clock domain's state.
+ *	In multi-core builds, this may be called from any thread; it retries, without blocking the
+ *	task, if it overlaps an update.
+ */
+void
+Cwsw_ClockCtx__GetSnapshot(const tCwswClockCtx *pCtx, ptCwswClockSnapshot pSnap)
+{
+#if (CWSW_CLOCK_MULTICORE)
+	uint32_t seq;
+#endif
+
+	if(!pCtx || !pSnap)		{ return; }
+
+#if (CWSW_CLOCK_MULTICORE)
+	do {
+		seq = atomic_load_explicit(&pCtx->statseq, memory_order_acquire);
+		pSnap->tic = CLK_PEEK(pCtx->thistic);
+		pSnap->sinceinit = Cwsw_ElapsedTimeMs(CLK_PEEK(pCtx->clockoffset), pSnap->tic);
+		pSnap->maxmissed = CLK_PEEK(pCtx->maxct);
+		pSnap->hbfailed = CLK_PEEK(pCtx->hbfailed);
+		atomic_thread_fence(memory_order_acquire);
+	} while((seq & 1) || (seq != atomic_load_explicit(&pCtx->statseq, memory_order_relaxed)));
+#else
+	pSnap->tic = pCtx->thistic;
+	pSnap->sinceinit = Cwsw_ElapsedTimeMs(pCtx->clockoffset, pCtx->thistic);
+	pSnap->maxmissed = pCtx->maxct;
+	pSnap->hbfailed = pCtx->hbfailed;
+#endif
+}
+
+
+/**	Request that the next task call of a clock domain return no later than the specified tic. */
+void
+Cwsw_ClockCtx__SetWakeup(ptCwswClockCtx pCtx, tCwswClockTics tm)
+{
+	if(!pCtx)		{ return; }
+
+	// keep the earliest of several requests made before the next task call.
+	if(!pCtx->wakeuppending || (Cwsw_ElapsedTimeMs(pCtx->wakeuptic, tm) < 0))
+	{
+		pCtx->wakeuptic = tm;
+		pCtx->wakeuppending = true;
+	}
+}
+
+
+/**	Credit a clock domain with tics counted before a restart; see Cwsw_ClockSvc__Rebase(). */
+void
+Cwsw_ClockCtx__Rebase(ptCwswClockCtx pCtx, tCwswClockTics sinceinit)
+{
+	if(!pCtx)		{ return; }
+
+	clock_stats_begin(pCtx);
+	CLK_POKE(pCtx->clockoffset, Cwsw_ElapsedTimeMs(sinceinit, CLK_PEEK(pCtx->clockoffset)));
+	clock_stats_end(pCtx);
+}
+
+
+/**	Block until a clock domain reaches the specified tic; see Cwsw_ClockSvc__WaitUntil(). */
+tCwswClockTics
+Cwsw_ClockCtx__WaitUntil(ptCwswClockCtx pCtx, tCwswClockTics tic)
+{
+	if(!pCtx)		{ return 0; }
+
+#if (CWSW_CLOCK_MULTICORE)
+	clock_block(pCtx, tic);
+#else
+	clock_run_until(pCtx, tic);
+#endif
+	return CLK_LOAD(pCtx->thistic);
+}
+
+
+/**	Block until a clock domain's next tic. */
+tCwswClockTics
+Cwsw_ClockCtx__WaitHeartbeat(ptCwswClockCtx pCtx)
+{
+	if(!pCtx)		{ return 0; }
+	return Cwsw_ClockCtx__WaitUntil(pCtx, Cwsw_TicsAfter(CLK_LOAD(pCtx->thistic), 1));
+}
+
+
+#if (CWSW_CLOCK_POLLFD)
+/**	Open a clock domain's pollable descriptor, if not already open; see Cwsw_ClockSvc__OpenPollFd().
+ *	@returns The descriptor, or -1 on failure.
+ */
+int
+Cwsw_ClockCtx__OpenPollFd(ptCwswClockCtx pCtx)
+{
+	int fd;
+
+	if(!pCtx)		{ return -1; }
+
+	fd = CLK_LOAD(pCtx->pollfd);
+	if(fd < 0)
+	{
+#if (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_MONOTONIC)
+		fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+#else
+		fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+#endif
+		CLK_STORE(pCtx->pollfd, fd);
+	}
+	return fd;
+}
+
+
+/**	Make a clock domain's pollable descriptor readable once the specified tic arrives. */
+void
+Cwsw_ClockCtx__ArmPollFd(ptCwswClockCtx pCtx, tCwswClockTics tic)
+{
+#if (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_MONOTONIC)
+	struct itimerspec its = { { 0, 0 }, { 0, 0 } };
+#endif
+
+	if(!pCtx || (CLK_PEEK(pCtx->pollfd) < 0))	{ return; }
+
+#if (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_MONOTONIC)
+	its.it_value = clock_tic_time(tic);
+	if(!its.it_value.tv_sec && !its.it_value.tv_nsec)	{ its.it_value.tv_nsec = 1; }	// all-zero would disarm it
+	(void)timerfd_settime(CLK_PEEK(pCtx->pollfd), TFD_TIMER_ABSTIME, &its, NULL);
+#else
+	CLK_POKE(pCtx->polltic, tic);
+	CLK_STORE(pCtx->pollarmed, true);
+#endif
+}
+
+
+/**	Consume the readiness of a clock domain's pollable descriptor. */
+void
+Cwsw_ClockCtx__AckPollFd(ptCwswClockCtx pCtx)
+{
+	uint64_t count;
+
+	if(!pCtx || (CLK_PEEK(pCtx->pollfd) < 0))	{ return; }
+	(void)!read(CLK_PEEK(pCtx->pollfd), &count, sizeof(count));
+}
+
+
+/**	Close a clock domain's pollable descriptor. */
+void
+Cwsw_ClockCtx__ClosePollFd(ptCwswClockCtx pCtx)
+{
+	if(!pCtx || (CLK_PEEK(pCtx->pollfd) < 0))	{ return; }
+
+#if (CWSW_CLOCK_BACKEND != CWSW_CLOCK_BACKEND_MONOTONIC)
+	CLK_STORE(pCtx->pollarmed, false);
+#endif
+	(void)close(CLK_PEEK(pCtx->pollfd));
+	CLK_STORE(pCtx->pollfd, -1);
+}
+#endif
+
+
+#if (CWSW_CLOCK_HISTOGRAMS)
+/**	Histogram of the gaps between consecutive tics of a clock domain. */
+ptCwswTicHist
+Cwsw_ClockCtx__GapHistogram(ptCwswClockCtx pCtx)
+{
+	return pCtx ? &pCtx->gaphist : NULL;
+}
+#endif
+
+
+#if (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_MONOTONIC)
+uint64_t
+Cwsw_ClockSvc__MonotonicNs(void)
+{
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+#endif
+
+
+// ---- default domain ------------------------------------------------------
+
+tCwswClockTics
+Cwsw_ClockSvc__TimerTic(void)
+{
+	return CLK_LOAD(defaultclock.thistic);
+}
+
+
+tCwswClockTics
+Cwsw_ClockSvc__Now(void)
+{
+	return Cwsw_ClockCtx__Now(&defaultclock);
+}
+
+
+tCwswClockTics
+Cwsw_ClockSvc__Task(void)
+{
+	return Cwsw_ClockCtx__Task(&defaultclock);
+}
+
+
+void
+Cwsw_ClockSvc__Init(ptEvQ_QueueCtrlEx pEvQX, int16_t HeatbeatEvId)
+{
+	Cwsw_ClockCtx__Init(&defaultclock, pEvQX, HeatbeatEvId);
+}
+
+
+tClkSvc_ErrorCode
+Cwsw_ClockSvc__SetTimer(pCwswClockTics pTimer, tCwswClockTics duration)
+{
+	return Cwsw_ClockCtx__SetTimer(&defaultclock, pTimer, duration);
+}
+
+
 tCwswClockTics
 Cwsw_ClockSvc__GetMaxMissedTics(void)
 {
-	return maxct;
+	return Cwsw_ClockCtx__GetMaxMissedTics(&defaultclock);
+}
+
+
+/**	Take a consistent snapshot of the clock's state.
+ *	In multi-core builds, this may be called from any thread; it retries, without blocking the
+ *	task, if it overlaps an update.
+ */
+void
+Cwsw_ClockSvc__GetSnapshot(ptCwswClockSnapshot pSnap)
+{
+	Cwsw_ClockCtx__GetSnapshot(&defaultclock, pSnap);
+}
+
+
+void
+Cwsw_ClockSvc__SetWakeup(tCwswClockTics tm)
+{
+	Cwsw_ClockCtx__SetWakeup(&defaultclock, tm);
+}
+
+
+#if (CWSW_CLOCK_HISTOGRAMS)
+ptCwswTicHist
+Cwsw_ClockSvc__GapHistogram(void)
+{
+	return Cwsw_ClockCtx__GapHistogram(&defaultclock);
+}
+#endif
+
+
+void
+Cwsw_ClockSvc__Rebase(tCwswClockTics sinceinit)
+{
+	Cwsw_ClockCtx__Rebase(&defaultclock, sinceinit);
+}
+
+
+tCwswClockTics
+Cwsw_ClockSvc__WaitUntil(tCwswClockTics tic)
+{
+	return Cwsw_ClockCtx__WaitUntil(&defaultclock, tic);
+}
+
+
+tCwswClockTics
+Cwsw_ClockSvc__WaitHeartbeat(void)
+{
+	return Cwsw_ClockCtx__WaitHeartbeat(&defaultclock);
+}
+
+
+#if (CWSW_CLOCK_POLLFD)
+int
+Cwsw_ClockSvc__OpenPollFd(void)
+{
+	return Cwsw_ClockCtx__OpenPollFd(&defaultclock);
+}
+
+
+void
+Cwsw_ClockSvc__ArmPollFd(tCwswClockTics tic)
+{
+	Cwsw_ClockCtx__ArmPollFd(&defaultclock, tic);
+}
+
+
+void
+Cwsw_ClockSvc__AckPollFd(void)
+{
+	Cwsw_ClockCtx__AckPollFd(&defaultclock);
+}
+
+
+void
+Cwsw_ClockSvc__ClosePollFd(void)
+{
+	Cwsw_ClockCtx__ClosePollFd(&defaultclock);
 }
+#endif
@@ -0,0 +1,337 @@
+/** @file
+ *	@brief	CWSW Fast Clock: fresh, fine-grained timestamps at the cost of a few nanoseconds.
+ *
+ *	Description:
+ *	TSC time is `ns0 + (((tsc - tsc0) * mult) >> 32)`: an anchor pair taken from `CLOCK_MONOTONIC`
+ *	and the TSC together, and the length of a TSC tick in 32.32 fixed-point nanoseconds. Each resync
+ *	measures the true rate over the interval since the previous one, and re-anchors. Time never
+ *	steps backwards: if TSC time has run ahead of the monotonic clock, the new anchor keeps TSC time,
+ *	and the rate is trimmed so the lead is worked off by the next resync.
+ *
+ *	The calibration is written only by the thread driving the default clock domain, and published
+ *	with a seqlock, as are the clock statistics, so any thread can read the clock without writing
+ *	shared state.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+
+// ----	Project Headers -------------------------
+#include "projcfg.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_clock.h"
+#include "cwsw_fastclock.h"
+
+#if (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_MONOTONIC)
+
+#if (CWSW_CLOCK_TSC)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+#if (CWSW_CLOCK_MULTICORE)
+#define FC_PEEK(var)			atomic_load_explicit(&(var), memory_order_relaxed)
+#define FC_POKE(var, val)		atomic_store_explicit(&(var), (val), memory_order_relaxed)
+#else
+#define FC_PEEK(var)			(var)
+#define FC_POKE(var, val)		((var) = (val))
+#endif
+
+enum { kSamplesPerPair = 5 };	//!< Readings taken to find one tightly bracketed (TSC, monotonic) pair.
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+#if (CWSW_CLOCK_TSC)
+/**	Wide enough for a 64 x 64-bit product. A GNU extension; so marked, to keep -Wpedantic quiet. */
+__extension__ typedef unsigned __int128 tFcU128;
+#endif
+
+/**	Published calibration. */
+typedef struct sFastClockCal {
+	CWSW_CLOCK_SHARED(uint32_t)	seq;		/**< Odd while the calibration is being updated. */
+	CWSW_CLOCK_SHARED(bool)		usetsc;
+	CWSW_CLOCK_SHARED(uint64_t)	tsc0;
+	CWSW_CLOCK_SHARED(uint64_t)	ns0;
+	CWSW_CLOCK_SHARED(uint64_t)	mult;		/**< Nanoseconds per TSC tick, 32.32 fixed point. */
+	CWSW_CLOCK_SHARED(uint64_t)	tschz;
+	CWSW_CLOCK_SHARED(uint32_t)	resyncs;
+	CWSW_CLOCK_SHARED(int64_t)	lastadjns;
+} tFastClockCal;
+
+
+// ============================================================================
+// ----	Global Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+static tFastClockCal	fc_cal;
+
+#if (CWSW_CLOCK_TSC)
+// owner only: the last pair measured, and when to measure the next.
+static uint64_t			fc_basetsc;
+static uint64_t			fc_basens;
+static uint64_t			fc_truemult;	/**< Rate measured at the last resync, before any trim. */
+static uint64_t			fc_nextsync;
+#endif
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+#if (CWSW_CLOCK_TSC)
+
+/**	Does this CPU have an invariant TSC, and `rdtscp` to read it? */
+static bool
+fc_invariant_tsc(void)
+{
+	unsigned int a, b, c, d;
+
+	if(!__get_cpuid(0x80000001, &a, &b, &c, &d) || !(d & (1U << 27)))	{ return false; }	// rdtscp
+	if(!__get_cpuid(0x80000007, &a, &b, &c, &d) || !(d & (1U << 8)))	{ return false; }	// invariant TSC
+	return true;
+}
+
+/**	Read the TSC, after every earlier instruction has executed. */
+static uint64_t
+fc_rdtsc(void)
+{
+	unsigned int aux;
+
+	return __rdtscp(&aux);
+}
+
+/**	Take a (TSC, monotonic) pair: of several tries, the one with the monotonic read most tightly
+ *	bracketed by TSC reads, taking the TSC value midway.
+ */
+static void
+fc_sample(uint64_t *pTsc, uint64_t *pNs)
+{
+	uint64_t best = UINT64_MAX;
+	uint64_t before;
+	uint64_t after;
+	uint64_t ns;
+	int n;
+
+	for(n = 0; n < kSamplesPerPair; ++n)
+	{
+		before = fc_rdtsc();
+		ns = Cwsw_ClockSvc__MonotonicNs();
+		after = fc_rdtsc();
+		if((after >= before) && ((after - before) < best))
+		{
+			best = after - before;
+			*pTsc = before + (best / 2);
+			*pNs = ns;
+		}
+	}
+}
+
+/**	TSC time at `tsc`, by the given calibration. */
+static uint64_t
+fc_convert(uint64_t tsc, uint64_t tsc0, uint64_t ns0, uint64_t mult)
+{
+	uint64_t dt = (tsc > tsc0) ? (tsc - tsc0) : 0;	// a TSC read on a core a little behind
+
+	return ns0 + (uint64_t)(((tFcU128)dt * mult) >> 32);
+}
+
+/**	Rate of the TSC between two pairs, in 32.32 fixed-point nanoseconds per tick. */
+static uint64_t
+fc_rate(uint64_t tsc0, uint64_t ns0, uint64_t tsc1, uint64_t ns1)
+{
+	return (uint64_t)(((tFcU128)(ns1 - ns0) << 32) / (tsc1 - tsc0));
+}
+
+/**	Publish a new calibration. */
+static void
+fc_publish(bool usetsc, uint64_t tsc0, uint64_t ns0, uint64_t mult)
+{
+#if (CWSW_CLOCK_MULTICORE)
+	(void)atomic_fetch_add_explicit(&fc_cal.seq, 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+#endif
+	FC_POKE(fc_cal.usetsc, usetsc);
+	FC_POKE(fc_cal.tsc0, tsc0);
+	FC_POKE(fc_cal.ns0, ns0);
+	FC_POKE(fc_cal.mult, mult);
+#if (CWSW_CLOCK_MULTICORE)
+	(void)atomic_fetch_add_explicit(&fc_cal.seq, 1, memory_order_release);
+#endif
+}
+
+#endif
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+/**	Calibrate the fast clock. Called by Cwsw_ClockSvc__Init(); where the TSC is in use, this takes
+ *	kCwswFastClock_CalibrateNs. Until it has run, readings come from clock_gettime().
+ */
+void
+Cwsw_FastClock__Init(void)
+{
+#if (CWSW_CLOCK_TSC)
+	uint64_t tsc0 = 0, ns0 = 0;
+	uint64_t tsc1 = 0, ns1 = 0;
+
+	fc_publish(false, 0, 0, 0);
+	FC_POKE(fc_cal.tschz, 0);
+	FC_POKE(fc_cal.resyncs, 0);
+	FC_POKE(fc_cal.lastadjns, 0);
+	if(!fc_invariant_tsc())	{ return; }
+
+	fc_sample(&tsc0, &ns0);
+	do {
+		fc_sample(&tsc1, &ns1);
+	} while((ns1 - ns0) < kCwswFastClock_CalibrateNs);
+	if(tsc1 <= tsc0)		{ return; }
+
+	fc_truemult = fc_rate(tsc0, ns0, tsc1, ns1);
+	fc_basetsc = tsc1;
+	fc_basens = ns1;
+	fc_nextsync = ns1 + kCwswFastClock_ResyncNs;
+	FC_POKE(fc_cal.tschz, (uint64_t)((1000000000ULL << 32) / fc_truemult));
+	fc_publish(true, tsc1, ns1, fc_truemult);
+#endif
+}
+
+
+/**	Read the time afresh.
+ *	@returns Nanoseconds on the `CLOCK_MONOTONIC` timeline.
+ */
+uint64_t
+Cwsw_FastClock__NowNs(void)
+{
+#if (CWSW_CLOCK_TSC)
+	bool usetsc;
+	uint64_t tsc0, ns0, mult;
+#if (CWSW_CLOCK_MULTICORE)
+	uint32_t seq;
+
+	do {
+		seq = atomic_load_explicit(&fc_cal.seq, memory_order_acquire);
+		usetsc = FC_PEEK(fc_cal.usetsc);
+		tsc0 = FC_PEEK(fc_cal.tsc0);
+		ns0 = FC_PEEK(fc_cal.ns0);
+		mult = FC_PEEK(fc_cal.mult);
+		atomic_thread_fence(memory_order_acquire);
+	} while((seq & 1) || (seq != atomic_load_explicit(&fc_cal.seq, memory_order_relaxed)));
+#else
+	usetsc = fc_cal.usetsc;
+	tsc0 = fc_cal.tsc0;
+	ns0 = fc_cal.ns0;
+	mult = fc_cal.mult;
+#endif
+
+	if(usetsc)	{ return fc_convert(fc_rdtsc(), tsc0, ns0, mult); }
+#endif
+
+	return Cwsw_ClockSvc__MonotonicNs();
+}
+
+
+/**	Re-synchronize the TSC with the monotonic clock now.
+ *	Normally left to the default clock domain's task (see Cwsw_FastClock__Poll()); call only from
+ *	the thread that drives it.
+ */
+void
+Cwsw_FastClock__Resync(void)
+{
+#if (CWSW_CLOCK_TSC)
+	uint64_t tsc = 0, ns = 0;
+	uint64_t truemult;
+	uint64_t skew;
+	uint64_t shown;
+	uint64_t lead;
+	uint64_t mult;
+
+	if(!FC_PEEK(fc_cal.usetsc))	{ return; }
+
+	fc_sample(&tsc, &ns);
+	if((tsc <= fc_basetsc) || (ns <= fc_basens))	{ return; }
+
+	// a change of rate beyond what oscillator drift explains means the TSC can't be trusted (e.g.,
+	// the host migrated a virtual machine); fall back to the monotonic clock for good.
+	truemult = fc_rate(fc_basetsc, fc_basens, tsc, ns);
+	skew = (truemult > fc_truemult) ? (truemult - fc_truemult) : (fc_truemult - truemult);
+	if(skew > ((fc_truemult / 1000000) * kCwswFastClock_MaxSkewPpm))
+	{
+		FC_POKE(fc_cal.tschz, 0);
+		fc_publish(false, 0, 0, 0);
+		return;
+	}
+
+	// what readers are shown now; if it leads the monotonic clock, hold it, and slow the rate to
+	// work off the lead over the next interval.
+	shown = fc_convert(tsc, FC_PEEK(fc_cal.tsc0), FC_PEEK(fc_cal.ns0), FC_PEEK(fc_cal.mult));
+	lead = (shown > ns) ? (shown - ns) : 0;
+	mult = truemult;
+	if(lead)
+	{
+		if(lead >= (kCwswFastClock_ResyncNs / 2))	{ lead = kCwswFastClock_ResyncNs / 2; }
+		mult = truemult - (uint64_t)(((tFcU128)truemult * lead) / kCwswFastClock_ResyncNs);
+	}
+
+	fc_truemult = truemult;
+	fc_basetsc = tsc;
+	fc_basens = ns;
+	fc_nextsync = ns + kCwswFastClock_ResyncNs;
+	FC_POKE(fc_cal.tschz, (uint64_t)((1000000000ULL << 32) / truemult));
+	FC_POKE(fc_cal.resyncs, FC_PEEK(fc_cal.resyncs) + 1);
+	FC_POKE(fc_cal.lastadjns, (int64_t)(ns - shown));
+	fc_publish(true, tsc, ns + ((shown > ns) ? (shown - ns) : 0), mult);
+#endif
+}
+
+
+/**	Re-synchronize if it's time. Called by the default clock domain's task on each new tic.
+ *	@param [in]	nowns	Current time, in ns on the monotonic timeline.
+ */
+void
+Cwsw_FastClock__Poll(uint64_t nowns)
+{
+#if (CWSW_CLOCK_TSC)
+	if(FC_PEEK(fc_cal.usetsc) && (nowns >= fc_nextsync))	{ Cwsw_FastClock__Resync(); }
+#else
+	(void)nowns;
+#endif
+}
+
+
+/**	Report the state of the fast clock. */
+void
+Cwsw_FastClock__GetInfo(ptCwswFastClockInfo pInfo)
+{
+	if(!pInfo)	{ return; }
+
+	pInfo->tsc = FC_PEEK(fc_cal.usetsc);
+	pInfo->tschz = FC_PEEK(fc_cal.tschz);
+	pInfo->resyncs = FC_PEEK(fc_cal.resyncs);
+	pInfo->lastadjns = FC_PEEK(fc_cal.lastadjns);
+}
+
+#endif
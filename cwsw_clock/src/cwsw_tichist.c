@@ -0,0 +1,189 @@
+/** @file
+ *	@brief	CWSW Tic Histograms: low-overhead latency and jitter instrumentation.
+ *
+ *	Description:
+ *	Values below kTicHist_SubBuckets have a bucket each. Above that, a value whose most significant
+ *	bit is `msb` falls in power-of-2 range (msb - kTicHist_SubBucketBits + 1), and within that range
+ *	in the bucket selected by the kTicHist_SubBucketBits bits just below the msb.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+
+// ----	Project Headers -------------------------
+#include "projcfg.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_tichist.h"
+
+#if (CWSW_CLOCK_HISTOGRAMS)
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+#if (CWSW_CLOCK_MULTICORE)
+#define HIST_LOAD(var)			atomic_load_explicit(&(var), memory_order_relaxed)
+#define HIST_INC(var)			(void)atomic_fetch_add_explicit(&(var), 1, memory_order_relaxed)
+#define HIST_TAKE(var, reset)	((reset) ? atomic_exchange_explicit(&(var), 0, memory_order_relaxed) : HIST_LOAD(var))
+#else
+#define HIST_LOAD(var)			(var)
+#define HIST_INC(var)			(++(var))
+#define HIST_TAKE(var, reset)	hist_take(&(var), (reset))
+#endif
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Global Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+#if !(CWSW_CLOCK_MULTICORE)
+static uint32_t
+hist_take(uint32_t *pCounter, bool reset)
+{
+	uint32_t val = *pCounter;
+	if(reset)	{ *pCounter = 0; }
+	return val;
+}
+#endif
+
+static uint32_t
+hist_msb(uint32_t value)
+{
+#if defined(__GNUC__)
+	return 31U - (uint32_t)__builtin_clz(value);
+#else
+	uint32_t msb = 0;
+	while(value >>= 1)	{ ++msb; }
+	return msb;
+#endif
+}
+
+static uint32_t
+hist_bucket_of(uint32_t value)
+{
+	uint32_t shift;
+
+	if(value < kTicHist_SubBuckets)	{ return value; }
+
+	shift = hist_msb(value) - kTicHist_SubBucketBits;
+	return ((shift + 1) << kTicHist_SubBucketBits) + ((value >> shift) & (kTicHist_SubBuckets - 1));
+}
+
+/**	Highest value that falls in a bucket. */
+static uint32_t
+hist_bucket_top(uint32_t bucket)
+{
+	uint32_t shift;
+	uint32_t base;
+
+	if(bucket < (2 * kTicHist_SubBuckets))	{ return bucket; }
+
+	shift = (bucket >> kTicHist_SubBucketBits) - 1;
+	base = (kTicHist_SubBuckets + (bucket & (kTicHist_SubBuckets - 1))) << shift;
+	return base + ((1UL << shift) - 1);
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+/**	Record one value.
+ *	Lock-free; in multi-core builds, any number of threads may record into the same histogram.
+ */
+void
+Cwsw_TicHist__Record(ptCwswTicHist pHist, uint32_t value)
+{
+	if(!pHist)		{ return; }
+
+	HIST_INC(pHist->counts[hist_bucket_of(value)]);
+
+#if (CWSW_CLOCK_MULTICORE)
+	{
+		uint32_t max = HIST_LOAD(pHist->max);
+		while((value > max) &&
+			!atomic_compare_exchange_weak_explicit(&pHist->max, &max, value, memory_order_relaxed, memory_order_relaxed))
+		{
+			// `max` has been refreshed; try again if we still exceed it.
+		}
+	}
+#else
+	if(value > pHist->max)	{ pHist->max = value; }
+#endif
+}
+
+
+/**	Summarize a histogram, and optionally begin a new window.
+ *	With `reset`, each bucket is read and cleared in one atomic step, so no sample recorded
+ *	concurrently is lost; it lands either in this window or in the next.
+ *
+ *	Reported percentiles are the highest value of the bucket in which they fall, capped at the
+ *	observed maximum.
+ *
+ *	@param [in,out]	pHist	Histogram.
+ *	@param [out]	pSnap	Summary.
+ *	@param [in]		reset	Clear the histogram after reading it.
+ */
+void
+Cwsw_TicHist__Snapshot(ptCwswTicHist pHist, ptCwswTicHistSnapshot pSnap, bool reset)
+{
+	static const uint32_t permille[] = { 500, 990, 999 };
+	uint32_t *pResult[3];
+	uint32_t counts[kTicHist_Buckets];
+	uint64_t cumulative = 0;
+	uint64_t target;
+	uint32_t bucket;
+	uint32_t q = 0;
+
+	if(!pHist || !pSnap)	{ return; }
+
+	pResult[0] = &pSnap->p50;
+	pResult[1] = &pSnap->p99;
+	pResult[2] = &pSnap->p999;
+
+	pSnap->count = 0;
+	for(bucket = 0; bucket < kTicHist_Buckets; ++bucket)
+	{
+		counts[bucket] = HIST_TAKE(pHist->counts[bucket], reset);
+		pSnap->count += counts[bucket];
+	}
+	pSnap->max = HIST_TAKE(pHist->max, reset);
+	pSnap->p50 = pSnap->p99 = pSnap->p999 = 0;
+
+	if(!pSnap->count)	{ return; }
+
+	for(bucket = 0; (bucket < kTicHist_Buckets) && (q < 3); ++bucket)
+	{
+		cumulative += counts[bucket];
+		while(q < 3)
+		{
+			target = ((uint64_t)pSnap->count * permille[q] + 999) / 1000;
+			if(cumulative < target)	{ break; }
+			*pResult[q++] = (hist_bucket_top(bucket) < pSnap->max) ? hist_bucket_top(bucket) : pSnap->max;
+		}
+	}
+}
+
+#endif /* CWSW_CLOCK_HISTOGRAMS */
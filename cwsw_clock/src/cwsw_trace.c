@@ -0,0 +1,335 @@
+/** @file
+ *	@brief	CWSW Trace Recorder: a flight recorder of tic and alarm activity.
+ *
+ *	Description:
+ *	Each ring has a single writer, its owning thread, so recording needs no atomic read-modify-write:
+ *	the writer fills the slot at `head`, then publishes it by storing `head + 1` with release
+ *	semantics. Readers copy records without stopping the writer, and then discard any record the
+ *	writer might have overwritten meanwhile, judged by re-reading `head`; the scheme is the seqlock
+ *	clock services use for their statistics, with the record index standing in for the sequence.
+ *
+ *	Attached rings form a list that only ever grows, so a reader can walk it at any time without
+ *	locking.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <inttypes.h>
+#include <string.h>
+
+// ----	Project Headers -------------------------
+#include "projcfg.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_clock.h"
+#include "cwsw_trace.h"
+
+#if (CWSW_CLOCK_TRACE)
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+#if (CWSW_CLOCK_MULTICORE)
+#define TRACE_LOAD(var)			atomic_load_explicit(&(var), memory_order_acquire)
+#define TRACE_STORE(var, val)	atomic_store_explicit(&(var), (val), memory_order_release)
+#define TRACE_PEEK(var)			atomic_load_explicit(&(var), memory_order_relaxed)
+#define TRACE_FENCE(order)		atomic_thread_fence(order)
+#define TRACE_TLS				_Thread_local
+#else
+#define TRACE_LOAD(var)			(var)
+#define TRACE_STORE(var, val)	((var) = (val))
+#define TRACE_PEEK(var)			(var)
+#define TRACE_FENCE(order)
+#define TRACE_TLS
+#endif
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/**	How a record type appears in a trace viewer. */
+typedef struct sTraceTypeInfo {
+	const char	*name;
+	const char	*argname;	/**< Label for the record's `arg`; NULL if it carries none. */
+} tTraceTypeInfo;
+
+
+// ============================================================================
+// ----	Global Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+/**	Ring of the calling thread; NULL if it doesn't record. */
+static TRACE_TLS ptCwswTraceRing	trace_thisring;
+
+/**	Every ring ever attached, most recent first. */
+static CWSW_CLOCK_SHARED(ptCwswTraceRing)	trace_rings;
+
+/**	Last thread number assigned. */
+static CWSW_CLOCK_SHARED(uint32_t)	trace_lasttid;
+
+static const tTraceTypeInfo trace_types[] = {
+	[kCwswTrace_None]			= { "none",				NULL },
+	[kCwswTrace_Tic]			= { "tic",				"gap" },
+	[kCwswTrace_AlarmArmed]		= { "alarm armed",		"due_in" },
+	[kCwswTrace_AlarmFired]		= { "alarm fired",		NULL },
+	[kCwswTrace_AlarmLate]		= { "alarm late",		"late_by" },
+	[kCwswTrace_AlarmCancelled]	= { "alarm cancelled",	NULL },
+	[kCwswTrace_EvPosted]		= { "event posted",		NULL },
+	[kCwswTrace_EvPostFailed]	= { "event post failed", "err" },
+	[kCwswTrace_EvDeferred]		= { "event deferred",	"depth" },
+	[kCwswTrace_EvDropped]		= { "event dropped",	NULL },
+};
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/**	Timestamp for a new record. */
+static uint64_t
+trace_now(void)
+{
+#if (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_MONOTONIC)
+	return Cwsw_FastClock__NowNs();
+#else
+	return CWSW_CLOCK_TICS_TO_NS(Cwsw_ClockSvc__TimerTic());
+#endif
+}
+
+/**	Add a ring to the list of rings. */
+static void
+trace_list(ptCwswTraceRing pRing)
+{
+#if (CWSW_CLOCK_MULTICORE)
+	pRing->tid = atomic_fetch_add_explicit(&trace_lasttid, 1, memory_order_relaxed) + 1;
+	pRing->pNext = atomic_load_explicit(&trace_rings, memory_order_relaxed);
+	while(!atomic_compare_exchange_weak_explicit(&trace_rings, &pRing->pNext, pRing,
+			memory_order_release, memory_order_relaxed))
+	{
+		// pNext has been refreshed with the current list; try again.
+	}
+#else
+	pRing->tid = ++trace_lasttid;
+	pRing->pNext = trace_rings;
+	trace_rings = pRing;
+#endif
+}
+
+/**	Write a string as the body of a JSON string, leaving out anything that would need escaping. */
+static void
+trace_json_str(FILE *fp, const char *s)
+{
+	for(; *s; ++s)
+	{
+		if((*s != '"') && (*s != '\\') && ((unsigned char)*s >= ' '))	{ (void)fputc(*s, fp); }
+	}
+}
+
+/**	Write one record as a trace event, preceded by the comma that separates it from the last. */
+static void
+trace_json_rec(FILE *fp, const tCwswTraceRing *pRing, const tCwswTraceRec *pRec)
+{
+	const tTraceTypeInfo *pInfo = NULL;
+	uint64_t us = pRec->ns / 1000;
+	unsigned frac = (unsigned)(pRec->ns % 1000);
+
+	if(pRec->type < (sizeof(trace_types) / sizeof(trace_types[0])))	{ pInfo = &trace_types[pRec->type]; }
+
+	if(pRec->type == kCwswTrace_Tic)
+	{
+		// a counter track, so the gap between tics plots as a graph.
+		(void)fprintf(fp, ",\n{\"name\":\"tic gap\",\"ph\":\"C\",\"pid\":1,\"tid\":%" PRIu32
+			",\"ts\":%" PRIu64 ".%03u,\"args\":{\"tics\":%" PRIu32 "}}",
+			pRing->tid, us, frac, pRec->arg);
+		return;
+	}
+
+	if(pInfo && pInfo->name)
+	{
+		(void)fprintf(fp, ",\n{\"name\":\"%s\"", pInfo->name);
+	}
+	else
+	{
+		(void)fprintf(fp, ",\n{\"name\":\"user %u\"", (unsigned)pRec->type);
+	}
+	(void)fprintf(fp, ",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%" PRIu32 ",\"ts\":%" PRIu64 ".%03u"
+		",\"args\":{\"id\":%u", pRing->tid, us, frac, (unsigned)pRec->id);
+	if(!pInfo || !pInfo->name)
+	{
+		(void)fprintf(fp, ",\"arg\":%" PRIu32, pRec->arg);
+	}
+	else if(pInfo->argname)
+	{
+		(void)fprintf(fp, ",\"%s\":%" PRIu32, pInfo->argname, pRec->arg);
+	}
+	(void)fputs("}}", fp);
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+/**	Start recording on the calling thread.
+ *	The ring stays in the recorder's list for the life of the process, so that its records can be
+ *	written out even after its thread has ended; its storage must last as long. Attach each ring
+ *	once.
+ *
+ *	@param [out]	pRing		Ring to initialize and bind to the calling thread.
+ *	@param [in]		pRecs		Storage for the records.
+ *	@param [in]		capacity	Number of records in the storage; a power of 2.
+ *	@param [in]		name		Name for the thread in trace viewers; may be NULL. Not copied.
+ *	@returns true if the ring was attached; false for a bad parameter.
+ */
+bool
+Cwsw_Trace__Attach(ptCwswTraceRing pRing, ptCwswTraceRec pRecs, uint32_t capacity, const char *name)
+{
+	if(!pRing || !pRecs || !capacity || (capacity & (capacity - 1)))	{ return false; }
+
+	memset(pRing, 0, sizeof(*pRing));
+	pRing->mask = capacity - 1;
+	pRing->pRecs = pRecs;
+	pRing->name = name;
+	trace_list(pRing);
+
+	trace_thisring = pRing;
+	return true;
+}
+
+
+/**	Stop recording on the calling thread. Its ring, and the records in it, remain. */
+void
+Cwsw_Trace__Detach(void)
+{
+	trace_thisring = NULL;
+}
+
+
+/**	Record one event on the calling thread's ring; nothing if the thread has none.
+ *	Normally called through CWSW_TRACE().
+ */
+void
+Cwsw_Trace__Record(uint8_t type, uint16_t id, uint32_t arg)
+{
+	ptCwswTraceRing pRing = trace_thisring;
+	ptCwswTraceRec pRec;
+	uint64_t head;
+
+	if(!pRing)	{ return; }
+
+	head = TRACE_PEEK(pRing->head);
+	// publish the previous record's index before overwriting any slot; see Cwsw_Trace__Collect().
+	TRACE_FENCE(memory_order_release);
+
+	pRec = &pRing->pRecs[head & pRing->mask];
+	pRec->ns = trace_now();
+	pRec->arg = arg;
+	pRec->id = id;
+	pRec->type = type;
+	pRec->rsvd = 0;
+	TRACE_STORE(pRing->head, head + 1);
+}
+
+
+/**	Copy the most recent records of a ring, oldest first.
+ *	Safe to call while the ring's owner records; records it overwrites during the copy are left out.
+ *
+ *	@param [in]		pRing	Ring to read.
+ *	@param [out]	pOut	Storage for the copies.
+ *	@param [in]		nmax	Number of records `pOut` holds.
+ *	@returns Number of records copied.
+ */
+uint32_t
+Cwsw_Trace__Collect(const tCwswTraceRing *pRing, ptCwswTraceRec pOut, uint32_t nmax)
+{
+	uint64_t capacity;
+	uint64_t head;
+	uint64_t first;
+	uint64_t after;
+	uint64_t n;
+	uint64_t i;
+
+	if(!pRing || !pOut || !nmax)	{ return 0; }
+
+	capacity = (uint64_t)pRing->mask + 1;
+	head = TRACE_LOAD(pRing->head);
+	n = (head < capacity) ? head : capacity;
+	if(n > nmax)	{ n = nmax; }
+	first = head - n;
+
+	for(i = 0; i < n; ++i)	{ pOut[i] = pRing->pRecs[(first + i) & pRing->mask]; }
+
+	// the writer may have published up to `after`, and be writing record `after`, which shares a
+	// slot with record `after - capacity`; anything at or before that one may be torn.
+	TRACE_FENCE(memory_order_acquire);
+	after = TRACE_PEEK(pRing->head);
+	if(after + 1 > first + capacity)
+	{
+		uint64_t drop = after + 1 - capacity - first;
+
+		if(drop >= n)	{ return 0; }
+		memmove(pOut, &pOut[drop], (size_t)(n - drop) * sizeof(*pOut));
+		n -= drop;
+	}
+	return (uint32_t)n;
+}
+
+
+/**	Write every ring's records as Chrome trace-event JSON.
+ *	The output opens in `chrome://tracing` and in the Perfetto UI. Each ring appears as a thread;
+ *	tic gaps plot as a counter, and everything else as instant events. Safe to call while threads
+ *	record.
+ *
+ *	@param [in]		fp			Open stream to write to.
+ *	@param [in]		pScratch	Storage in which to collect each ring's records in turn.
+ *	@param [in]		nscratch	Number of records `pScratch` holds; at most this many are written per
+ *								ring, the most recent.
+ *	@returns Number of records written, or -1 on a bad parameter or a write error.
+ */
+int
+Cwsw_Trace__WriteJson(FILE *fp, ptCwswTraceRec pScratch, uint32_t nscratch)
+{
+	const tCwswTraceRing *pRing;
+	uint32_t n;
+	uint32_t i;
+	int total = 0;
+
+	if(!fp || !pScratch || !nscratch)	{ return -1; }
+
+	// the header carries a dummy metadata event, so every event after it can lead with a comma.
+	(void)fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+		"{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"cwsw\"}}", fp);
+
+	for(pRing = TRACE_LOAD(trace_rings); pRing; pRing = pRing->pNext)
+	{
+		(void)fprintf(fp, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%" PRIu32
+			",\"args\":{\"name\":\"", pRing->tid);
+		if(pRing->name)	{ trace_json_str(fp, pRing->name); }
+		else			{ (void)fprintf(fp, "thread %" PRIu32, pRing->tid); }
+		(void)fputs("\"}}", fp);
+
+		n = Cwsw_Trace__Collect(pRing, pScratch, nscratch);
+		for(i = 0; i < n; ++i)	{ trace_json_rec(fp, pRing, &pScratch[i]); }
+		total += (int)n;
+	}
+
+	(void)fputs("\n]}\n", fp);
+	return ferror(fp) ? -1 : total;
+}
+
+#endif
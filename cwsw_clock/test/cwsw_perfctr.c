@@ -0,0 +1,274 @@
+/** @file
+ *	@brief	CWSW Performance Counters: cost measurement for benchmarks of clock services and alarms.
+ *
+ *	Description:
+ *	The counters are opened disabled, per thread, on any CPU, counting user space only; Start()
+ *	resets and enables them, Stop() disables and reads them, so the measured stretch excludes the
+ *	cost of the bracketing calls as far as practical.
+ *
+ *	The allocation count is process-wide: allocations made by other threads during a measured
+ *	stretch count too.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <stdatomic.h>
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "cwsw_perfctr.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Global Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+static _Atomic uint64_t perf_allocs;	//!< Allocations since the program started.
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+#if defined(__linux__)
+static int
+perf_open(uint64_t config)
+{
+	struct perf_event_attr attr;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.config = config;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+static uint64_t
+perf_read(int fd)
+{
+	uint64_t count = 0;
+
+#if defined(__linux__)
+	if((fd < 0) || (read(fd, &count, sizeof(count)) != (ssize_t)sizeof(count)))	{ count = 0; }
+#else
+	(void)fd;
+#endif
+	return count;
+}
+
+static void
+perf_control(const tCwswPerfCtr *pCtr, bool enable)
+{
+#if defined(__linux__)
+	if(!pCtr->hwcounters)	{ return; }
+	if(enable)
+	{
+		(void)ioctl(pCtr->fdcycles, PERF_EVENT_IOC_RESET, 0);
+		(void)ioctl(pCtr->fdmisses, PERF_EVENT_IOC_RESET, 0);
+		(void)ioctl(pCtr->fdcycles, PERF_EVENT_IOC_ENABLE, 0);
+		(void)ioctl(pCtr->fdmisses, PERF_EVENT_IOC_ENABLE, 0);
+	}
+	else
+	{
+		(void)ioctl(pCtr->fdcycles, PERF_EVENT_IOC_DISABLE, 0);
+		(void)ioctl(pCtr->fdmisses, PERF_EVENT_IOC_DISABLE, 0);
+	}
+#else
+	(void)pCtr;
+	(void)enable;
+#endif
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+#if (CWSW_PERFCTR_ALLOCS)
+/**	@name Allocation counters.
+ *	Installed in place of the C library's allocator entry points by the linker's --wrap option.
+ */
+//! @{
+extern void *__real_malloc(size_t size);
+extern void *__real_calloc(size_t nmemb, size_t size);
+extern void *__real_realloc(void *ptr, size_t size);
+void *__wrap_malloc(size_t size);
+void *__wrap_calloc(size_t nmemb, size_t size);
+void *__wrap_realloc(void *ptr, size_t size);
+
+void *
+__wrap_malloc(size_t size)
+{
+	(void)atomic_fetch_add_explicit(&perf_allocs, 1, memory_order_relaxed);
+	return __real_malloc(size);
+}
+
+void *
+__wrap_calloc(size_t nmemb, size_t size)
+{
+	(void)atomic_fetch_add_explicit(&perf_allocs, 1, memory_order_relaxed);
+	return __real_calloc(nmemb, size);
+}
+
+void *
+__wrap_realloc(void *ptr, size_t size)
+{
+	(void)atomic_fetch_add_explicit(&perf_allocs, 1, memory_order_relaxed);
+	return __real_realloc(ptr, size);
+}
+//! @}
+#endif
+
+
+/**	Monotonic time, in nanoseconds; for benchmarks that time events of their own. */
+uint64_t
+Cwsw_PerfCtr__NowNs(void)
+{
+#if defined(__linux__)
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+#else
+	return ((uint64_t)clock() * 1000000000ULL) / CLOCKS_PER_SEC;
+#endif
+}
+
+
+/**	Open a counter set for the calling thread.
+ *	@returns true if hardware counters (cycles, cache misses) are available; elapsed time is always
+ *	measured.
+ */
+bool
+Cwsw_PerfCtr__Open(ptCwswPerfCtr pCtr)
+{
+	if(!pCtr)		{ return false; }
+
+	memset(pCtr, 0, sizeof(*pCtr));
+	pCtr->fdcycles = -1;
+	pCtr->fdmisses = -1;
+
+#if defined(__linux__)
+	pCtr->fdcycles = perf_open(PERF_COUNT_HW_CPU_CYCLES);
+	pCtr->fdmisses = perf_open(PERF_COUNT_HW_CACHE_MISSES);
+	pCtr->hwcounters = (pCtr->fdcycles >= 0) && (pCtr->fdmisses >= 0);
+	if(!pCtr->hwcounters)	{ Cwsw_PerfCtr__Close(pCtr); }
+#endif
+	return pCtr->hwcounters;
+}
+
+
+/**	Release a counter set. */
+void
+Cwsw_PerfCtr__Close(ptCwswPerfCtr pCtr)
+{
+	if(!pCtr)		{ return; }
+
+#if defined(__linux__)
+	if(pCtr->fdcycles >= 0)	{ (void)close(pCtr->fdcycles); }
+	if(pCtr->fdmisses >= 0)	{ (void)close(pCtr->fdmisses); }
+#endif
+	pCtr->fdcycles = -1;
+	pCtr->fdmisses = -1;
+	pCtr->hwcounters = false;
+}
+
+
+/**	Begin a measured stretch. */
+void
+Cwsw_PerfCtr__Start(ptCwswPerfCtr pCtr)
+{
+	if(!pCtr)		{ return; }
+
+	perf_control(pCtr, true);
+	pCtr->startcycles = perf_read(pCtr->fdcycles);
+	pCtr->startmisses = perf_read(pCtr->fdmisses);
+	pCtr->startallocs = atomic_load_explicit(&perf_allocs, memory_order_relaxed);
+	pCtr->startns = Cwsw_PerfCtr__NowNs();
+}
+
+
+/**	End a measured stretch.
+ *
+ *	@param [in,out]	pCtr	Counter set.
+ *	@param [out]	pSample	Totals for the stretch.
+ *	@param [in]		ops		Number of operations the stretch performed, for per-operation reporting.
+ */
+void
+Cwsw_PerfCtr__Stop(ptCwswPerfCtr pCtr, ptCwswPerfSample pSample, uint64_t ops)
+{
+	uint64_t stopns = Cwsw_PerfCtr__NowNs();
+	uint64_t stopallocs = atomic_load_explicit(&perf_allocs, memory_order_relaxed);
+
+	if(!pCtr || !pSample)	{ return; }
+
+	perf_control(pCtr, false);
+	pSample->ops = ops;
+	pSample->ns = stopns - pCtr->startns;
+	pSample->cycles = perf_read(pCtr->fdcycles) - pCtr->startcycles;
+	pSample->cachemisses = perf_read(pCtr->fdmisses) - pCtr->startmisses;
+	pSample->allocs = stopallocs - pCtr->startallocs;
+}
+
+
+/**	Format a measurement as one line of JSON (no trailing newline):
+ *	`{"bench":"<name>","param":N,"ops":N,"ns_per_op":X,"cycles_per_op":X,"misses_per_op":X,"allocs":N}`
+ *
+ *	`param` is the benchmark's scaling parameter (e.g., the number of alarms). `allocs` is the total
+ *	for the stretch, not per operation, since any nonzero count is worth seeing; it is null when
+ *	allocations aren't counted.
+ *
+ *	@returns Length of the formatted line, as for snprintf().
+ */
+int
+Cwsw_PerfCtr__Format(char *buf, size_t len, const char *name, uint64_t param, const tCwswPerfSample *pSample)
+{
+	double ops;
+	char allocs[24];
+
+	if(!buf || !name || !pSample)	{ return -1; }
+
+	if(CWSW_PERFCTR_ALLOCS)	{ (void)snprintf(allocs, sizeof(allocs), "%llu", (unsigned long long)pSample->allocs); }
+	else					{ (void)snprintf(allocs, sizeof(allocs), "null"); }
+
+	ops = pSample->ops ? (double)pSample->ops : 1.0;
+	return snprintf(buf, len,
+		"{\"bench\":\"%s\",\"param\":%llu,\"ops\":%llu,\"ns_per_op\":%.3f,\"cycles_per_op\":%.3f,\"misses_per_op\":%.4f,\"allocs\":%s}",
+		name, (unsigned long long)param, (unsigned long long)pSample->ops,
+		(double)pSample->ns / ops, (double)pSample->cycles / ops, (double)pSample->cachemisses / ops, allocs);
+}
@@ -0,0 +1,115 @@
+/** @file
+ *	@brief	CWSW Performance Counters: cost measurement for benchmarks of clock services and alarms.
+ *
+ *	Measures a stretch of code in elapsed nanoseconds, CPU cycles, cache misses and heap allocations,
+ *	and reports the result per operation as one line of JSON, suitable for collecting and trending
+ *	across builds. Cycles and cache misses come from the Linux perf_event interface; where it isn't
+ *	available (other hosts, or perf_event_paranoid forbids it), they read as 0 and `hwcounters` is
+ *	false.
+ *
+ *	Allocations are counted when CWSW_PERFCTR_ALLOCS is nonzero, by wrappers around malloc(),
+ *	calloc() and realloc(); the program must then be linked with
+ *	`-Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc` (GNU ld, or compatible). Otherwise `allocs`
+ *	is reported as null.
+ *
+ *	For benchmark programs only; not part of the library.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef CWSW_PERFCTR_H
+#define CWSW_PERFCTR_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+#if !defined(CWSW_PERFCTR_ALLOCS)
+#define CWSW_PERFCTR_ALLOCS		0
+#endif
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/**	Counter set. One per measuring thread; counts only that thread. */
+typedef struct sCwswPerfCtr {
+	int			fdcycles;		/**< perf_event descriptor for CPU cycles; -1 if unavailable. */
+	int			fdmisses;		/**< perf_event descriptor for cache misses; -1 if unavailable. */
+	bool		hwcounters;		/**< Both hardware counters are available. */
+	uint64_t	startns;
+	uint64_t	startcycles;
+	uint64_t	startmisses;
+	uint64_t	startallocs;
+} tCwswPerfCtr, *ptCwswPerfCtr;
+
+/**	Result of one measurement. */
+typedef struct sCwswPerfSample {
+	uint64_t	ops;			/**< Operations performed in the measured stretch. */
+	uint64_t	ns;
+	uint64_t	cycles;
+	uint64_t	cachemisses;
+	uint64_t	allocs;			/**< Heap allocations; 0 unless CWSW_PERFCTR_ALLOCS is set. */
+} tCwswPerfSample, *ptCwswPerfSample;
+
+
+// ============================================================================
+// ----	Public Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+// ---- Discrete Functions -------------------------------------------------- {
+
+extern bool Cwsw_PerfCtr__Open(ptCwswPerfCtr pCtr);
+extern void Cwsw_PerfCtr__Close(ptCwswPerfCtr pCtr);
+extern void Cwsw_PerfCtr__Start(ptCwswPerfCtr pCtr);
+extern void Cwsw_PerfCtr__Stop(ptCwswPerfCtr pCtr, ptCwswPerfSample pSample, uint64_t ops);
+extern int Cwsw_PerfCtr__Format(char *buf, size_t len, const char *name, uint64_t param, const tCwswPerfSample *pSample);
+extern uint64_t Cwsw_PerfCtr__NowNs(void);
+
+// ---- /Discrete Functions ------------------------------------------------- }
+
+// ---- Targets for Get/Set APIs -------------------------------------------- {
+
+/** "Chapter Designator" for Get/Set API.
+ *	Intentionally unused symbol, designed to get you to the correct starting
+ *	point, when you want to find macros for the Get/Set API; simply highlight
+ *	the Module argument in your IDE (e.g, Eclipse, NetBeans, etc.), and select
+ *	Go To Definition.
+ */
+enum { Cwsw_PerfCtr };	/* Component ID for Performance Counters */
+
+// ---- /Targets for Get/Set APIs ------------------------------------------- }
+
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* CWSW_PERFCTR_H */
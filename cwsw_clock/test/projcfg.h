@@ -0,0 +1,19 @@
+/** @file
+ *	@brief	Project configuration for the benchmark and test programs of clock services and alarms.
+ *
+ *	Build options (CWSW_CLOCK_BACKEND and the like) are given on the compiler command line, by the
+ *	makefiles, so that one source can be built in several configurations.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef PROJCFG_H
+#define PROJCFG_H
+
+#include "cwsw_lib.h"
+
+#endif /* PROJCFG_H */
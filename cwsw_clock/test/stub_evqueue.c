@@ -0,0 +1,88 @@
+/** @file
+ *	@brief	Stub Extended Event Queue, for benchmarks and tests of clock services and alarms.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stddef.h>
+#include <string.h>
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "stub_evqueue.h"
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+/**	Initialize a stub queue over caller-supplied storage.
+ *
+ *	@param [out]	pStub		Stub to initialize.
+ *	@param [in]		pEvents		Ring storage; NULL to discard every event posted.
+ *	@param [in]		capacity	Number of events in the storage.
+ *	@returns The queue control to hand to the library (e.g., as an alarm's queue).
+ */
+ptEvQ_QueueCtrlEx
+Cwsw_StubEvQ__Init(ptStubEvQ pStub, tEvQ_Event *pEvents, uint32_t capacity)
+{
+	if(!pStub)		{ return NULL; }
+
+	memset(pStub, 0, sizeof(*pStub));
+	pStub->pEvents = pEvents;
+	pStub->capacity = pEvents ? capacity : 0;
+	return &pStub->ctrl;
+}
+
+
+/**	Take the oldest event from a stub queue.
+ *	@returns true if an event was taken.
+ */
+bool
+Cwsw_StubEvQ__Get(ptStubEvQ pStub, ptEvQ_Event pEv)
+{
+	if(!pStub || !pEv || !pStub->count)	{ return false; }
+
+	*pEv = pStub->pEvents[pStub->head];
+	if(++pStub->head >= pStub->capacity)	{ pStub->head = 0; }
+	--pStub->count;
+	return true;
+}
+
+
+/**	Post an event; stands in for the event queue component.
+ *	@returns 0 if the event was accepted; kErr_EvQ_QueueFull if the ring is full.
+ */
+tErrorCodes_EvQ
+Cwsw_EvQX__PostEvent(ptEvQ_QueueCtrlEx pEvQX, tEvQ_Event ev)
+{
+	ptStubEvQ pStub = (ptStubEvQ)pEvQX;		// ctrl is the stub's first member
+	uint32_t tail;
+
+	if(!pStub)		{ return kErr_EvQ_BadParm; }
+
+	if(pStub->pEvents)
+	{
+		if(pStub->count >= pStub->capacity)
+		{
+			++pStub->rejected;
+			return kErr_EvQ_QueueFull;
+		}
+		tail = pStub->head + pStub->count;
+		if(tail >= pStub->capacity)	{ tail -= pStub->capacity; }
+		pStub->pEvents[tail] = ev;
+		++pStub->count;
+	}
+	++pStub->posted;
+	return kErr_EvQ_NoError;
+}
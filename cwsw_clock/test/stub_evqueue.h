@@ -0,0 +1,84 @@
+/** @file
+ *	@brief	Stub Extended Event Queue, for benchmarks and tests of clock services and alarms.
+ *
+ *	Provides Cwsw_EvQX__PostEvent() in place of the event queue component, over a plain ring of
+ *	caller-supplied storage, so the cost of the component itself stays out of the measurements. The
+ *	queue control structure handed to the library is embedded in the stub; its contents are never
+ *	looked at, so the stub works with any definition of tEvQ_QueueCtrlEx.
+ *
+ *	A stub with no storage accepts and discards every event. Not thread-safe.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef STUB_EVQUEUE_H
+#define STUB_EVQUEUE_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdint.h>
+#include <stdbool.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_evqueue_ex.h"	/* tEvQ_Event, tEvQ_QueueCtrlEx */
+
+// ----	Module Headers --------------------------
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/**	One stub queue. */
+typedef struct sStubEvQ {
+	tEvQ_QueueCtrlEx	ctrl;		/**< Handed to the library; must be first. */
+	tEvQ_Event			*pEvents;	/**< Caller-supplied ring; NULL to discard every event. */
+	uint32_t			capacity;
+	uint32_t			head;		/**< Index of the oldest event held. */
+	uint32_t			count;		/**< Events held. */
+	uint64_t			posted;		/**< Events accepted. */
+	uint64_t			rejected;	/**< Posts refused because the ring was full. */
+} tStubEvQ, *ptStubEvQ;
+
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+// ---- Discrete Functions -------------------------------------------------- {
+
+extern ptEvQ_QueueCtrlEx Cwsw_StubEvQ__Init(ptStubEvQ pStub, tEvQ_Event *pEvents, uint32_t capacity);
+extern bool Cwsw_StubEvQ__Get(ptStubEvQ pStub, ptEvQ_Event pEv);
+
+// ---- /Discrete Functions ------------------------------------------------- }
+
+// ---- Targets for Get/Set APIs -------------------------------------------- {
+
+/** "Chapter Designator" for Get/Set API.
+ *	Intentionally unused symbol, designed to get you to the correct starting
+ *	point, when you want to find macros for the Get/Set API; simply highlight
+ *	the Module argument in your IDE (e.g, Eclipse, NetBeans, etc.), and select
+ *	Go To Definition.
+ */
+enum { Cwsw_StubEvQ };	/* Component ID for Stub Event Queue */
+
+// ---- /Targets for Get/Set APIs ------------------------------------------- }
+
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* STUB_EVQUEUE_H */
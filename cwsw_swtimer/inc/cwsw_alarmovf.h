@@ -0,0 +1,145 @@
+/** @file
+ *	@brief	CWSW SW Alarm Overflow: backpressure-aware delivery of alarm events.
+ *
+ *	An event queue that is full when an alarm matures would otherwise lose the alarm's event. Attach
+ *	an overflow buffer to the queue, and every alarm event bound for it that can't be posted is held
+ *	there instead, and retried on the next tic; events held for a queue are posted before any newer
+ *	event, so the consumer sees them in order. When the buffer itself fills, its policy decides what
+ *	gives way. Counters record what was deferred, retried, coalesced and lost, so an overloaded
+ *	consumer can be seen, and degrades predictably.
+ *
+ *	Buffers cover every path that delivers alarm events (Cwsw_SwAlarm__Deliver()). Alarm schedulers,
+ *	tables and static schedules retry held events on each of their task calls; with polled alarms
+ *	only, call Cwsw_SwAlarmOvf__RetryAll() once per heartbeat. Events bound for a queue with no
+ *	buffer that fail to post are lost, and counted as such.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef CWSW_ALARMOVF_H
+#define CWSW_ALARMOVF_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdint.h>
+#include <stdbool.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_clock.h"			/* CWSW_CLOCK_SHARED */
+
+// ----	Module Headers --------------------------
+#include "cwsw_swtimer.h"		/* tErrorCodes_SwTmr */
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/**	What gives way when an overflow buffer is full. */
+enum eSwAlarmOvfPolicy {
+	kSwAlarmOvf_DropNewest,			//!< The event that didn't fit is lost.
+	kSwAlarmOvf_Coalesce,			//!< An event with the same ID already held takes the new event's data; otherwise as DropNewest.
+	kSwAlarmOvf_OverwriteOldest		//!< The oldest event held is lost, to make room.
+};
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+typedef enum eSwAlarmOvfPolicy tSwAlarmOvfPolicy;
+
+/**	Delivery counters of one overflow buffer (or, for Cwsw_SwAlarmOvf__GetStats(NULL), of every
+ *	queue without one).
+ */
+typedef struct sCwswSwAlarmOvfStats {
+	uint32_t	deferred;	/**< Events held after a failed post. */
+	uint32_t	retried;	/**< Held events since posted. */
+	uint32_t	coalesced;	/**< Events merged into one already held. */
+	uint32_t	dropped;	/**< Events lost, whether new or held. */
+	uint16_t	maxdepth;	/**< Most events held at once. */
+} tCwswSwAlarmOvfStats, *ptCwswSwAlarmOvfStats;
+
+/**	Overflow buffer for one event queue.
+ *	A ring of events in caller-supplied storage, plus its counters. In multi-core builds, any thread
+ *	may deliver to the queue; a short spinlock guards the buffer, and is taken only while events are
+ *	held or a post fails. Treat the contents as private.
+ */
+typedef struct sCwswSwAlarmOverflow {
+	ptEvQ_QueueCtrlEx		pEvQX;		/**< Queue this buffer serves. */
+	tEvQ_Event				*pEvents;	/**< Caller-supplied storage. */
+	uint16_t				capacity;
+	uint16_t				head;		/**< Index of the oldest event held. */
+	CWSW_CLOCK_SHARED(uint16_t)	count;	/**< Events held. */
+	tSwAlarmOvfPolicy		policy;
+	tCwswSwAlarmOvfStats	stats;
+#if (CWSW_CLOCK_MULTICORE) && defined(__cplusplus)
+	std::atomic_flag		lock;
+#elif (CWSW_CLOCK_MULTICORE)
+	atomic_flag				lock;
+#endif
+	struct sCwswSwAlarmOverflow	*pNext;	/**< Next buffer attached. */
+} tCwswSwAlarmOverflow, *ptCwswSwAlarmOverflow;
+
+
+// ============================================================================
+// ----	Public Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+// ---- Discrete Functions -------------------------------------------------- {
+
+extern tErrorCodes_SwTmr Cwsw_SwAlarmOvf__Attach(
+	ptCwswSwAlarmOverflow	pOvf,
+	ptEvQ_QueueCtrlEx		pEvQX,
+	tEvQ_Event				*pEvents,
+	uint16_t				capacity,
+	tSwAlarmOvfPolicy		policy);
+extern void Cwsw_SwAlarmOvf__RetryAll(void);
+extern void Cwsw_SwAlarmOvf__GetStats(ptCwswSwAlarmOverflow pOvf, ptCwswSwAlarmOvfStats pStats, bool reset);
+extern uint16_t Cwsw_SwAlarmOvf__Depth(const tCwswSwAlarmOverflow *pOvf);
+
+/**	@name Delivery hooks.
+ *	For Cwsw_SwAlarm__Deliver(); not for application use.
+ */
+//! @{
+extern ptCwswSwAlarmOverflow Cwsw_SwAlarmOvf__Find(ptEvQ_QueueCtrlEx pEvQX);
+extern tErrorCodes_EvQ Cwsw_SwAlarmOvf__Retry(ptCwswSwAlarmOverflow pOvf);
+extern tErrorCodes_EvQ Cwsw_SwAlarmOvf__Defer(ptCwswSwAlarmOverflow pOvf, tEvQ_Event ev, tErrorCodes_EvQ err);
+//! @}
+
+// ---- /Discrete Functions ------------------------------------------------- }
+
+// ---- Targets for Get/Set APIs -------------------------------------------- {
+
+/** "Chapter Designator" for Get/Set API.
+ *	Intentionally unused symbol, designed to get you to the correct starting
+ *	point, when you want to find macros for the Get/Set API; simply highlight
+ *	the Module argument in your IDE (e.g, Eclipse, NetBeans, etc.), and select
+ *	Go To Definition.
+ */
+enum { Cwsw_SwAlarmOvf };	/* Component ID for SW Alarm Overflow */
+
+// ---- /Targets for Get/Set APIs ------------------------------------------- }
+
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* CWSW_ALARMOVF_H */
@@ -0,0 +1,111 @@
+/** @file
+ *	@brief	CWSW SW Alarm Pool: handle-based alarms for short-lived timeouts.
+ *
+ *	A fixed-capacity pool of alarms, all registered with one alarm scheduler, and referred to by
+ *	handle rather than by address. Acquire, arm, re-arm, cancel, release and remaining-time queries
+ *	are constant time, and nothing is allocated after the pool is initialized. Each handle carries
+ *	its slot's generation, so a handle kept after its alarm was released is reported as stale, not
+ *	silently applied to whichever alarm next occupies the slot.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef CWSW_ALARMPOOL_H
+#define CWSW_ALARMPOOL_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdint.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_clock.h"			/* tCwswClockTics */
+
+// ----	Module Headers --------------------------
+#include "cwsw_alarmsched.h"	/* tCwswSwAlarmSched */
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum eSwAlarmPoolLimits {
+	kSwAlarmPool_IndexBits		= 16,
+	kSwAlarmPool_MaxCapacity	= (1 << kSwAlarmPool_IndexBits) - 1,	//!< Largest pool; index 0xFFFF ends the free list.
+	kSwAlarmPool_InvalidHandle	= 0										//!< Never returned for a valid alarm.
+};
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/**	Alarm handle: (generation << kSwAlarmPool_IndexBits) | slot index. Generations are never 0. */
+typedef uint32_t tCwswSwAlarmHandle;
+
+/**	One slot of an alarm pool. */
+typedef struct sSwAlarmPoolSlot {
+	tCwswSwAlarm	alarm;
+	uint16_t		gen;		/**< Generation of the slot; advanced each time the slot is released. */
+	uint16_t		nextfree;	/**< While free: next free slot. */
+} tSwAlarmPoolSlot, *ptSwAlarmPoolSlot;
+
+/**	SW Alarm Pool. As with other CWSW tables, the slots are supplied by the caller. */
+typedef struct sCwswSwAlarmPool {
+	ptSwAlarmPoolSlot	pSlots;
+	uint16_t			capacity;
+	uint16_t			freehead;	/**< First free slot; kSwAlarmPool_MaxCapacity if none. */
+	uint16_t			nfree;
+	ptCwswSwAlarmSched	pSched;		/**< Scheduler that services the pool's alarms. */
+} tCwswSwAlarmPool, *ptCwswSwAlarmPool;
+
+
+// ============================================================================
+// ----	Public Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+// ---- Discrete Functions -------------------------------------------------- {
+
+extern tErrorCodes_SwTmr Cwsw_SwAlarmPool__Init(ptCwswSwAlarmPool pPool, ptSwAlarmPoolSlot pSlots, uint16_t capacity, ptCwswSwAlarmSched pSched);
+extern tCwswSwAlarmHandle Cwsw_SwAlarmPool__Acquire(ptCwswSwAlarmPool pPool, ptEvQ_QueueCtrlEx pEvQX, int16_t evid);
+extern tErrorCodes_SwTmr Cwsw_SwAlarmPool__Arm(ptCwswSwAlarmPool pPool, tCwswSwAlarmHandle hAlarm, tCwswClockTics duration, tCwswClockTics reloadtm);
+extern tErrorCodes_SwTmr Cwsw_SwAlarmPool__Cancel(ptCwswSwAlarmPool pPool, tCwswSwAlarmHandle hAlarm);
+extern tErrorCodes_SwTmr Cwsw_SwAlarmPool__Release(ptCwswSwAlarmPool pPool, tCwswSwAlarmHandle hAlarm);
+extern tErrorCodes_SwTmr Cwsw_SwAlarmPool__Remaining(ptCwswSwAlarmPool pPool, tCwswSwAlarmHandle hAlarm, pCwswClockTics pLeft);
+extern ptCwswSwAlarm Cwsw_SwAlarmPool__Alarm(ptCwswSwAlarmPool pPool, tCwswSwAlarmHandle hAlarm);
+
+// ---- /Discrete Functions ------------------------------------------------- }
+
+// ---- Targets for Get/Set APIs -------------------------------------------- {
+
+/** "Chapter Designator" for Get/Set API.
+ *	Intentionally unused symbol, designed to get you to the correct starting
+ *	point, when you want to find macros for the Get/Set API; simply highlight
+ *	the Module argument in your IDE (e.g, Eclipse, NetBeans, etc.), and select
+ *	Go To Definition.
+ */
+enum { Cwsw_SwAlarmPool };	/* Component ID for SW Alarm Pool */
+
+// ---- /Targets for Get/Set APIs ------------------------------------------- }
+
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* CWSW_ALARMPOOL_H */
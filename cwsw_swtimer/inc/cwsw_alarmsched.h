@@ -0,0 +1,132 @@
+/** @file
+ *	@brief	CWSW SW Alarm Scheduler (hierarchical timing wheel).
+ *
+ *	Alarms are registered with the scheduler once; thereafter, each heartbeat touches only those
+ *	alarms that actually mature, instead of polling every alarm through Cwsw_SwAlarm__ManageTimer().
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef CWSW_ALARMSCHED_H
+#define CWSW_ALARMSCHED_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdint.h>
+#include <stdbool.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_clock.h"		/* tCwswClockTics */
+
+// ----	Module Headers --------------------------
+#include "cwsw_swtimer.h"	/* tCwswSwAlarm */
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/**	Geometry of the timing wheel.
+ *	Each level has 2^kSwAlarmSched_SlotBits slots; level N covers timeouts up to
+ *	2^(kSwAlarmSched_SlotBits * (N+1)) tics. Four levels of 64 slots cover 2^24 tics (about 4.6
+ *	hours at 1 ms per tic); longer timeouts are parked in the outermost level and re-filed as time
+ *	advances.
+ */
+enum eSwAlarmSchedGeometry {
+	kSwAlarmSched_SlotBits	= 6,
+	kSwAlarmSched_Slots		= (1 << kSwAlarmSched_SlotBits),
+	kSwAlarmSched_SlotMask	= (kSwAlarmSched_Slots - 1),
+	kSwAlarmSched_Levels	= 4
+};
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/**	SW Alarm Scheduler.
+ *	Alarms are kept on intrusive lists, one per wheel slot, so registration and cancellation are
+ *	constant-time and the scheduler itself never allocates.
+ */
+typedef struct sCwswSwAlarmSched {
+	tCwswClockTics		curtic;		/**< Last tic fully serviced by the scheduler. */
+	ptCwswSwAlarm		pDue;		/**< Alarms already due at registration; serviced on the next task call. */
+	ptCwswSwAlarm		wheel[kSwAlarmSched_Levels][kSwAlarmSched_Slots];
+	uint64_t			occupied[kSwAlarmSched_Levels];	/**< One bit per nonempty slot (64 slots per level). */
+	uint32_t			nalarms;	/**< Number of alarms currently registered. */
+	uint32_t			nextseq;	/**< Registration sequence; see Cwsw_SwAlarmSched__SetOrdered(). */
+	bool				ordered;	/**< Alarms sharing a deadline mature in registration order. */
+	ptCwswSwAlarmBatch	pBatch;		/**< When set, events are collected here and delivered once per task call. */
+} tCwswSwAlarmSched, *ptCwswSwAlarmSched;
+
+/**	A group of alarms that are paused and resumed together, e.g. those of one subsystem.
+ *	Members are chained through their `pGroupNext` field, and point back at the group through their
+ *	`pGroup` field; an alarm belongs to at most one group.
+ */
+typedef struct sCwswSwAlarmGroup {
+	ptCwswSwAlarm		pMembers;
+} tCwswSwAlarmGroup, *ptCwswSwAlarmGroup;
+
+
+// ============================================================================
+// ----	Public Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+// ---- Discrete Functions -------------------------------------------------- {
+
+extern tErrorCodes_SwTmr Cwsw_SwAlarmSched__Init(ptCwswSwAlarmSched pSched);
+extern tErrorCodes_SwTmr Cwsw_SwAlarmSched__Register(ptCwswSwAlarmSched pSched, ptCwswSwAlarm pAlarm);
+extern tErrorCodes_SwTmr Cwsw_SwAlarmSched__Arm(ptCwswSwAlarmSched pSched, ptCwswSwAlarm pAlarm, tCwswClockTics duration);
+extern tErrorCodes_SwTmr Cwsw_SwAlarmSched__ArmAligned(ptCwswSwAlarmSched pSched, ptCwswSwAlarm pAlarm, tCwswClockTics period, tCwswClockTics phase);
+extern void Cwsw_SwAlarmSched__SetOrdered(ptCwswSwAlarmSched pSched, bool ordered);
+extern void Cwsw_SwAlarmSched__SetBatch(ptCwswSwAlarmSched pSched, ptCwswSwAlarmBatch pBatch);
+extern void Cwsw_SwAlarmSched__Cancel(ptCwswSwAlarmSched pSched, ptCwswSwAlarm pAlarm);
+extern void Cwsw_SwAlarmSched__Pause(ptCwswSwAlarmSched pSched, ptCwswSwAlarm pAlarm);
+extern void Cwsw_SwAlarmSched__Resume(ptCwswSwAlarmSched pSched, ptCwswSwAlarm pAlarm);
+extern void Cwsw_SwAlarmSched__GroupInit(ptCwswSwAlarmGroup pGroup);
+extern tErrorCodes_SwTmr Cwsw_SwAlarmSched__GroupAdd(ptCwswSwAlarmGroup pGroup, ptCwswSwAlarm pAlarm);
+extern void Cwsw_SwAlarmSched__GroupRemove(ptCwswSwAlarmGroup pGroup, ptCwswSwAlarm pAlarm);
+extern uint32_t Cwsw_SwAlarmSched__PauseGroup(ptCwswSwAlarmSched pSched, ptCwswSwAlarmGroup pGroup);
+extern uint32_t Cwsw_SwAlarmSched__ResumeGroup(ptCwswSwAlarmSched pSched, ptCwswSwAlarmGroup pGroup);
+extern uint32_t Cwsw_SwAlarmSched__Collect(ptCwswSwAlarmSched pSched, tCwswClockTics now);
+extern uint32_t Cwsw_SwAlarmSched__Advance(ptCwswSwAlarmSched pSched, tCwswClockTics now);
+extern uint32_t Cwsw_SwAlarmSched__Task(ptCwswSwAlarmSched pSched);
+extern bool Cwsw_SwAlarmSched__NextDeadline(ptCwswSwAlarmSched pSched, pCwswClockTics pDeadline);
+extern tCwswClockTics Cwsw_SwAlarmSched__Wait(ptCwswSwAlarmSched pSched);
+
+// ---- /Discrete Functions ------------------------------------------------- }
+
+// ---- Targets for Get/Set APIs -------------------------------------------- {
+
+/** "Chapter Designator" for Get/Set API.
+ *	Intentionally unused symbol, designed to get you to the correct starting
+ *	point, when you want to find macros for the Get/Set API; simply highlight
+ *	the Module argument in your IDE (e.g, Eclipse, NetBeans, etc.), and select
+ *	Go To Definition.
+ */
+enum { Cwsw_SwAlarmSched };	/* Component ID for SW Alarm Scheduler */
+
+// ---- /Targets for Get/Set APIs ------------------------------------------- }
+
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* CWSW_ALARMSCHED_H */
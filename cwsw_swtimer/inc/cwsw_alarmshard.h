@@ -0,0 +1,140 @@
+/** @file
+ *	@brief	CWSW Sharded SW Alarm Scheduler, for multi-core hosts.
+ *
+ *	Each worker thread owns one shard: an alarm scheduler (timing wheel) that only it touches, an
+ *	inbox through which any other thread may arm or cancel the shard's alarms, and a "ready" list
+ *	of events from alarms that matured on its last pass. Events on the ready list may be delivered
+ *	by any worker, so an idle worker can take delivery work from a busy one. So it is that several
+ *	workers may post to one event queue at once: queues targeted by sharded alarms must accept
+ *	concurrent posts.
+ *
+ *	Available only in multi-core builds (CWSW_CLOCK_MULTICORE), since each worker reads the clock.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef CWSW_ALARMSHARD_H
+#define CWSW_ALARMSHARD_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdint.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_clock.h"			/* CWSW_CLOCK_MULTICORE, CWSW_CLOCK_SHARED() */
+
+#if (CWSW_CLOCK_MULTICORE)
+
+// ----	Module Headers --------------------------
+#include "cwsw_alarmsched.h"	/* tCwswSwAlarmSched */
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum eSwAlarmShardSizes {
+	kSwAlarmShard_InboxSize	= 256,	//!< Pending cross-thread requests per shard; must be a power of 2.
+	kSwAlarmShard_ReadySize	= 256,	//!< Events staged for delivery per shard, per pass.
+	kSwAlarmShard_Rounds	= 2		//!< Ready lists per shard, used in turn by successive passes.
+};
+
+/**	Requests a foreign thread can make of a shard. */
+enum eSwAlarmShardOp {
+	kSwAlarmShardOp_Arm,
+	kSwAlarmShardOp_Cancel
+};
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/**	One slot of a shard's inbox (a bounded, lock-free, multi-producer queue).
+ *	`seq` tells producers and the consumer whose turn it is to use the slot.
+ */
+typedef struct sSwAlarmShardReq {
+	CWSW_CLOCK_SHARED(uint32_t)	seq;
+	ptCwswSwAlarm		pAlarm;
+	tCwswClockTics		deadline;	/**< For arm requests: the new deadline, as a raw clock tic. */
+	uint8_t				op;			/**< One of eSwAlarmShardOp. */
+} tSwAlarmShardReq;
+
+/**	One shard.
+ *	Fields written by foreign threads are kept on cache lines apart from the owner's working set.
+ */
+typedef struct sCwswSwAlarmShard {
+	// owner only
+	tCwswSwAlarmSched	sched;
+	tCwswSwAlarmBatch	staging;							/**< Collects events as the owner's alarms mature. */
+	uint32_t			inboxtail;							/**< Next inbox slot the owner will consume. */
+	uint16_t			nready[kSwAlarmShard_Rounds];		/**< Entries published on each ready list. */
+
+	// shared among workers: the ready lists. packed as (round << 32) | (count << 16) | (next unclaimed index);
+	//	round `r` uses list `r % kSwAlarmShard_Rounds`.
+	CWSW_CLOCK_LINE CWSW_CLOCK_SHARED(uint64_t)	work;
+	CWSW_CLOCK_SHARED(uint32_t)	ndone[kSwAlarmShard_Rounds];		/**< Entries of each list fully delivered. */
+	tSwAlarmBatchEntry	ready[kSwAlarmShard_Rounds][kSwAlarmShard_ReadySize];
+
+	// shared with foreign producers: the inbox.
+	CWSW_CLOCK_LINE CWSW_CLOCK_SHARED(uint32_t)	inboxhead;
+	tSwAlarmShardReq	inbox[kSwAlarmShard_InboxSize];
+} tCwswSwAlarmShard, *ptCwswSwAlarmShard;
+
+/**	A set of shards, one per worker thread. Storage is supplied by the caller. */
+typedef struct sCwswSwAlarmShardSet {
+	ptCwswSwAlarmShard	pShards;
+	uint16_t			nshards;
+} tCwswSwAlarmShardSet, *ptCwswSwAlarmShardSet;
+
+
+// ============================================================================
+// ----	Public Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+// ---- Discrete Functions -------------------------------------------------- {
+
+extern tErrorCodes_SwTmr Cwsw_SwAlarmShard__Init(ptCwswSwAlarmShardSet pSet, ptCwswSwAlarmShard pShards, uint16_t nshards);
+extern tErrorCodes_SwTmr Cwsw_SwAlarmShard__Arm(ptCwswSwAlarmShard pShard, ptCwswSwAlarm pAlarm, tCwswClockTics duration);
+extern tErrorCodes_SwTmr Cwsw_SwAlarmShard__Cancel(ptCwswSwAlarmShard pShard, ptCwswSwAlarm pAlarm);
+extern uint32_t Cwsw_SwAlarmShard__Task(ptCwswSwAlarmShardSet pSet, uint16_t self);
+extern uint32_t Cwsw_SwAlarmShard__Steal(ptCwswSwAlarmShardSet pSet, uint16_t self);
+
+// ---- /Discrete Functions ------------------------------------------------- }
+
+// ---- Targets for Get/Set APIs -------------------------------------------- {
+
+/** "Chapter Designator" for Get/Set API.
+ *	Intentionally unused symbol, designed to get you to the correct starting
+ *	point, when you want to find macros for the Get/Set API; simply highlight
+ *	the Module argument in your IDE (e.g, Eclipse, NetBeans, etc.), and select
+ *	Go To Definition.
+ */
+enum { Cwsw_SwAlarmShard };	/* Component ID for Sharded SW Alarm Scheduler */
+
+// ---- /Targets for Get/Set APIs ------------------------------------------- }
+
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* CWSW_CLOCK_MULTICORE */
+
+#endif /* CWSW_ALARMSHARD_H */
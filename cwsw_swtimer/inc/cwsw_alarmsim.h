@@ -0,0 +1,96 @@
+/** @file
+ *	@brief	CWSW SW Alarm Simulator: deterministic virtual-time execution of SW alarms.
+ *
+ *	A simulator is an alarm scheduler driven by its own virtual clock rather than by the clock
+ *	services. Virtual time moves only when the caller runs the simulator, and it moves straight from
+ *	one deadline to the next, so hours of simulated time cost no more than the alarms that mature
+ *	in them. Alarms sharing a deadline mature in the order they were armed, so a given sequence of
+ *	calls always produces the same sequence of events.
+ *
+ *	Simulators share no state with one another or with the clock services; any number may run side
+ *	by side (e.g., one per test case, or one per thread).
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef CWSW_ALARMSIM_H
+#define CWSW_ALARMSIM_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdint.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_clock.h"			/* tCwswClockTics */
+
+// ----	Module Headers --------------------------
+#include "cwsw_alarmsched.h"	/* tCwswSwAlarmSched */
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/**	SW Alarm Simulator. */
+typedef struct sCwswSwAlarmSim {
+	tCwswSwAlarmSched	sched;
+	tCwswClockTics		now;		/**< Virtual time. */
+} tCwswSwAlarmSim, *ptCwswSwAlarmSim;
+
+
+// ============================================================================
+// ----	Public Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+// ---- Discrete Functions -------------------------------------------------- {
+
+extern tErrorCodes_SwTmr Cwsw_SwAlarmSim__Init(ptCwswSwAlarmSim pSim, tCwswClockTics start);
+extern tErrorCodes_SwTmr Cwsw_SwAlarmSim__Arm(ptCwswSwAlarmSim pSim, ptCwswSwAlarm pAlarm, tCwswClockTics duration);
+extern void Cwsw_SwAlarmSim__Cancel(ptCwswSwAlarmSim pSim, ptCwswSwAlarm pAlarm);
+extern uint32_t Cwsw_SwAlarmSim__Step(ptCwswSwAlarmSim pSim, tCwswClockTics until);
+extern uint32_t Cwsw_SwAlarmSim__RunUntil(ptCwswSwAlarmSim pSim, tCwswClockTics until);
+extern uint32_t Cwsw_SwAlarmSim__RunFor(ptCwswSwAlarmSim pSim, tCwswClockTics duration);
+
+// ---- /Discrete Functions ------------------------------------------------- }
+
+// ---- Targets for Get/Set APIs -------------------------------------------- {
+
+/** "Chapter Designator" for Get/Set API.
+ *	Intentionally unused symbol, designed to get you to the correct starting
+ *	point, when you want to find macros for the Get/Set API; simply highlight
+ *	the Module argument in your IDE (e.g, Eclipse, NetBeans, etc.), and select
+ *	Go To Definition.
+ */
+enum { Cwsw_SwAlarmSim };	/* Component ID for SW Alarm Simulator */
+
+/** Current virtual time of a simulator. */
+#define Cwsw_SwAlarmSim__Now(pSim)	((pSim)->now)
+
+// ---- /Targets for Get/Set APIs ------------------------------------------- }
+
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* CWSW_ALARMSIM_H */
@@ -0,0 +1,108 @@
+/** @file
+ *	@brief	CWSW SW Alarm Snapshots: save and restore alarm state across a process restart.
+ *
+ *	A snapshot is a small binary file holding, for each alarm of a set, its remaining time, reload
+ *	time, slack, state, rearm policy and event binding, plus the clock's count of tics since
+ *	initialization. It is written through a memory mapping, to a temporary file that is synced to
+ *	storage and then renamed over the old snapshot, so a crash mid-save leaves the previous snapshot
+ *	intact. Restoring maps
+ *	the file, validates all of it, and only then applies it.
+ *
+ *	Deadlines are saved as time remaining and restored relative to the current tic, so time spent
+ *	down doesn't count: alarms keep their phase relative to one another, and there is no burst of
+ *	catch-up work. Pointers can't survive a restart, so an alarm's event queue is saved as its index
+ *	in a table of queues that the caller supplies both times; callbacks are not saved, and are left
+ *	as the caller set them.
+ *
+ *	Snapshots are in host byte order, and meant for a warm restart on the same host. Available on
+ *	POSIX hosts.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef CWSW_ALARMSNAP_H
+#define CWSW_ALARMSNAP_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdint.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_clock.h"			/* tCwswClockTics */
+
+// ----	Module Headers --------------------------
+#include "cwsw_alarmsched.h"	/* tCwswSwAlarmSched */
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum eSwAlarmSnapFormat {
+	kSwAlarmSnap_Magic		= 0x53415743,	//!< "CWAS", read as a little-endian word.
+	kSwAlarmSnap_Version	= 1
+};
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/**	The set of alarms saved to, and restored from, one snapshot.
+ *	The same alarms, in the same order, with the same table of queues, must be described on both
+ *	sides of the restart.
+ */
+typedef struct sCwswSwAlarmSnapSet {
+	ptCwswSwAlarm			pAlarms;
+	uint32_t				nalarms;
+	const ptEvQ_QueueCtrlEx	*pQueues;	/**< Every queue the alarms post to. */
+	uint16_t				nqueues;
+	ptCwswSwAlarmSched		pSched;		/**< Scheduler to register restored alarms with; NULL for polled alarms. */
+} tCwswSwAlarmSnapSet, *ptCwswSwAlarmSnapSet;
+
+
+// ============================================================================
+// ----	Public Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+// ---- Discrete Functions -------------------------------------------------- {
+
+extern tErrorCodes_SwTmr Cwsw_SwAlarmSnap__Save(const char *path, const tCwswSwAlarmSnapSet *pSet);
+extern tErrorCodes_SwTmr Cwsw_SwAlarmSnap__Restore(const char *path, const tCwswSwAlarmSnapSet *pSet);
+
+// ---- /Discrete Functions ------------------------------------------------- }
+
+// ---- Targets for Get/Set APIs -------------------------------------------- {
+
+/** "Chapter Designator" for Get/Set API.
+ *	Intentionally unused symbol, designed to get you to the correct starting
+ *	point, when you want to find macros for the Get/Set API; simply highlight
+ *	the Module argument in your IDE (e.g, Eclipse, NetBeans, etc.), and select
+ *	Go To Definition.
+ */
+enum { Cwsw_SwAlarmSnap };	/* Component ID for SW Alarm Snapshots */
+
+// ---- /Targets for Get/Set APIs ------------------------------------------- }
+
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* CWSW_ALARMSNAP_H */
@@ -0,0 +1,238 @@
+/** @file
+ *	@brief	CWSW Static Alarm Schedule: a fixed set of periodic alarms, laid out at compile time.
+ *
+ *	For a list of alarms known at build time (e.g., the tasks managed by tedlos), the whole
+ *	schedule can be worked out by the compiler: time is divided into minor frames, the frames of one
+ *	hyperperiod are numbered, and each frame's entry in a ROM-resident slot table is the set of
+ *	alarms due in it. At run time there is no per-alarm initialization, and each frame costs one
+ *	table read plus one post per alarm due; alarms that aren't due are never visited.
+ *
+ *	The alarm list is an X-macro taking an X macro and a pass-through argument:
+ *
+ *		#define MANAGED_ALARMS(X, t)										\
+ *			X(t, Sample,	CWSW_CLOCK_MS(10),	0,					evSample)	\
+ *			X(t, Report,	CWSW_CLOCK_MS(100),	CWSW_CLOCK_MS(20),	evReport)	\
+ *			X(t, Blink,		CWSW_CLOCK_MS(500),	CWSW_CLOCK_MS(50),	evBlink)
+ *
+ *		CWSW_ALARMSTATIC_DECLARE(tedlos, MANAGED_ALARMS);		// in a header
+ *		CWSW_ALARMSTATIC_DEFINE(tedlos, MANAGED_ALARMS, CWSW_CLOCK_MS(10), CWSW_CLOCK_MS(500), &osq);
+ *
+ *	Each entry gives a name, a period, a phase (offset of the first maturation from the start of
+ *	the schedule, less than the period), and the event to post. The definition states the minor
+ *	frame and hyperperiod; every period and phase must be a multiple of the minor frame, and the
+ *	hyperperiod a multiple of every period, all of which is checked at compile time. Alarms due in
+ *	the same frame are posted in list order.
+ *
+ *	C++ builds may instead use the constexpr front end in cwsw_alarmstatic.hpp, which derives the
+ *	minor frame and hyperperiod itself.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef CWSW_ALARMSTATIC_H
+#define CWSW_ALARMSTATIC_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdint.h>
+#include <stdbool.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_clock.h"		/* tCwswClockTics */
+
+// ----	Module Headers --------------------------
+#include "cwsw_swtimer.h"	/* tErrorCodes_SwTmr */
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/**	Largest number of minor frames in one hyperperiod of a C-defined schedule; one of 16, 32, 64,
+ *	128 or 256. Each table's slot array has this many entries.
+ */
+#if !defined(CWSW_ALARMSTATIC_MAX_FRAMES)
+#define CWSW_ALARMSTATIC_MAX_FRAMES		64
+#endif
+
+enum eSwAlarmStaticLimits {
+	kSwAlarmStatic_MaxAlarms	= 32,							//!< Alarms per schedule (one bit each in a slot).
+	kSwAlarmStatic_MaxFrames	= CWSW_ALARMSTATIC_MAX_FRAMES	//!< See CWSW_ALARMSTATIC_MAX_FRAMES.
+};
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/**	One alarm of a static schedule. */
+typedef struct sCwswSwAlarmStaticEntry {
+	tCwswClockTics		period;		/**< Tics between maturations. */
+	tCwswClockTics		phase;		/**< Tics from the start of the schedule to the first maturation. */
+	int16_t				evid;		/**< Event to post. */
+} tCwswSwAlarmStaticEntry;
+
+/**	A static schedule. Built entirely at compile time, and meant to live in ROM. */
+typedef struct sCwswSwAlarmStaticTable {
+	const tCwswSwAlarmStaticEntry	*pEntries;
+	const uint32_t		*pSlots;		/**< Per minor frame, a bit for each alarm due in it. */
+	ptEvQ_QueueCtrlEx	pEvQX;			/**< Queue for the schedule's events. */
+	tCwswClockTics		minor;			/**< Tics per minor frame. */
+	tCwswClockTics		hyperperiod;	/**< Tics after which the schedule repeats. */
+	uint16_t			nframes;		/**< Minor frames per hyperperiod. */
+	uint8_t				nentries;
+} tCwswSwAlarmStaticTable;
+
+/**	Run-time state of a static schedule.
+ *	Statically initialized to refer to its table; nothing else needs initializing, and the schedule
+ *	starts on the first task call unless Cwsw_SwAlarmStatic__Start() says otherwise.
+ */
+typedef struct sCwswSwAlarmStatic {
+	const tCwswSwAlarmStaticTable	*pTbl;
+	tCwswClockTics		nextframe;		/**< Tic at which the next frame begins. */
+	uint16_t			frame;			/**< Index of the next frame. */
+	bool				started;
+} tCwswSwAlarmStatic, *ptCwswSwAlarmStatic;
+
+
+// ============================================================================
+// ----	Public Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+// ---- Discrete Functions -------------------------------------------------- {
+
+extern void Cwsw_SwAlarmStatic__Start(ptCwswSwAlarmStatic pRun, tCwswClockTics epoch);
+extern uint32_t Cwsw_SwAlarmStatic__Advance(ptCwswSwAlarmStatic pRun, tCwswClockTics now);
+extern uint32_t Cwsw_SwAlarmStatic__Task(ptCwswSwAlarmStatic pRun);
+extern bool Cwsw_SwAlarmStatic__NextDeadline(const tCwswSwAlarmStatic *pRun, pCwswClockTics pDeadline);
+
+// ---- /Discrete Functions ------------------------------------------------- }
+
+/**	@name Static schedule generation.
+ *	CWSW_ALARMSTATIC_DECLARE() names each alarm's index (`<tbl>__<name>`) and the count
+ *	(`<tbl>__Count`), and declares the schedule `<tbl>_Schedule` and its run-time state `<tbl>`.
+ *	CWSW_ALARMSTATIC_DEFINE() checks the list and defines both, once, in a translation unit that has
+ *	seen the declaration.
+ */
+//! @{
+#define CWSW_ALARMSTATIC_DECLARE(tbl, LIST)										\
+	enum { LIST(CWSW_ALARMSTATIC__INDEX, tbl) tbl##__Count };					\
+	extern const tCwswSwAlarmStaticTable tbl##_Schedule;						\
+	extern tCwswSwAlarmStatic tbl
+
+#define CWSW_ALARMSTATIC_DEFINE(tbl, LIST, minor, hyper, pEvQX)					\
+	_Static_assert((tbl##__Count > 0) && ((int)tbl##__Count <= (int)kSwAlarmStatic_MaxAlarms),	\
+		"A static alarm schedule holds 1 to 32 alarms.");						\
+	_Static_assert(((minor) > 0) && (((hyper) % (minor)) == 0),					\
+		"The hyperperiod must be a multiple of the minor frame.");				\
+	_Static_assert(((hyper) / (minor)) <= kSwAlarmStatic_MaxFrames,				\
+		"Too many minor frames; raise CWSW_ALARMSTATIC_MAX_FRAMES.");			\
+	LIST(CWSW_ALARMSTATIC__CHECK, (minor, hyper))								\
+	static const tCwswSwAlarmStaticEntry tbl##__Entries[] = {					\
+		LIST(CWSW_ALARMSTATIC__ENTRY, tbl)										\
+	};																			\
+	static const uint32_t tbl##__Slots[kSwAlarmStatic_MaxFrames] = {			\
+		CWSW_ALARMSTATIC__REPEAT(CWSW_ALARMSTATIC__SLOT, 0, (tbl, LIST, minor, hyper))	\
+	};																			\
+	const tCwswSwAlarmStaticTable tbl##_Schedule = {							\
+		tbl##__Entries, tbl##__Slots, (pEvQX), (minor), (hyper),				\
+		(uint16_t)((hyper) / (minor)), (uint8_t)tbl##__Count					\
+	};																			\
+	tCwswSwAlarmStatic tbl = { &tbl##_Schedule, 0, 0, false }
+//! @}
+
+/**	@name Implementation of the generation macros; not for direct use. */
+//! @{
+#define CWSW_ALARMSTATIC__INDEX(t, name, period, phase, evid)	t##__##name,
+#define CWSW_ALARMSTATIC__ENTRY(t, name, period, phase, evid)	{ (period), (phase), (evid) },
+
+#define CWSW_ALARMSTATIC__CHECK(t, name, period, phase, evid)					\
+	_Static_assert(((period) > 0) && (((period) % CWSW_ALARMSTATIC__CK_MINOR t) == 0),	\
+		"Period of " #name " must be a multiple of the minor frame.");			\
+	_Static_assert(((phase) >= 0) && ((phase) < (period)) && (((phase) % CWSW_ALARMSTATIC__CK_MINOR t) == 0),	\
+		"Phase of " #name " must be a multiple of the minor frame, less than the period.");	\
+	_Static_assert((CWSW_ALARMSTATIC__CK_HYPER t % (period)) == 0,				\
+		"The hyperperiod must be a multiple of the period of " #name ".");
+
+/* one slot: the OR of the bits of the alarms due in frame `k`. */
+#define CWSW_ALARMSTATIC__SLOT(k, a)											\
+	(0UL CWSW_ALARMSTATIC__LIST a (CWSW_ALARMSTATIC__BIT,						\
+		(CWSW_ALARMSTATIC__TBL a, CWSW_ALARMSTATIC__MINOR a, CWSW_ALARMSTATIC__HYPER a, k))),
+#define CWSW_ALARMSTATIC__BIT(t, name, period, phase, evid)					\
+	| ((((CWSW_ALARMSTATIC__BIT_K t) < (CWSW_ALARMSTATIC__BIT_HYPER t / CWSW_ALARMSTATIC__BIT_MINOR t)) &&	\
+		((((CWSW_ALARMSTATIC__BIT_K t) * CWSW_ALARMSTATIC__BIT_MINOR t) % (period)) == (phase)))	\
+		? (1UL << CWSW_ALARMSTATIC__CAT(CWSW_ALARMSTATIC__BIT_TBL t, __##name)) : 0UL)
+
+#define CWSW_ALARMSTATIC__CK_MINOR(m, h)			m
+#define CWSW_ALARMSTATIC__CK_HYPER(m, h)			h
+#define CWSW_ALARMSTATIC__BIT_TBL(tbl, m, h, k)		tbl
+#define CWSW_ALARMSTATIC__BIT_MINOR(tbl, m, h, k)	m
+#define CWSW_ALARMSTATIC__BIT_HYPER(tbl, m, h, k)	h
+#define CWSW_ALARMSTATIC__BIT_K(tbl, m, h, k)		k
+#define CWSW_ALARMSTATIC__TBL(tbl, list, m, h)		tbl
+#define CWSW_ALARMSTATIC__LIST(tbl, list, m, h)		list
+#define CWSW_ALARMSTATIC__MINOR(tbl, list, m, h)	m
+#define CWSW_ALARMSTATIC__HYPER(tbl, list, m, h)	h
+#define CWSW_ALARMSTATIC__CAT(a, b)					CWSW_ALARMSTATIC__CAT_(a, b)
+#define CWSW_ALARMSTATIC__CAT_(a, b)				a##b
+
+/* M(k, a) for k = 0 .. CWSW_ALARMSTATIC_MAX_FRAMES - 1. */
+#define CWSW_ALARMSTATIC__R1(M, k, a)		M(k, a)
+#define CWSW_ALARMSTATIC__R2(M, k, a)		CWSW_ALARMSTATIC__R1(M, (2*(k)), a) CWSW_ALARMSTATIC__R1(M, (2*(k)+1), a)
+#define CWSW_ALARMSTATIC__R4(M, k, a)		CWSW_ALARMSTATIC__R2(M, (2*(k)), a) CWSW_ALARMSTATIC__R2(M, (2*(k)+1), a)
+#define CWSW_ALARMSTATIC__R8(M, k, a)		CWSW_ALARMSTATIC__R4(M, (2*(k)), a) CWSW_ALARMSTATIC__R4(M, (2*(k)+1), a)
+#define CWSW_ALARMSTATIC__R16(M, k, a)		CWSW_ALARMSTATIC__R8(M, (2*(k)), a) CWSW_ALARMSTATIC__R8(M, (2*(k)+1), a)
+#define CWSW_ALARMSTATIC__R32(M, k, a)		CWSW_ALARMSTATIC__R16(M, (2*(k)), a) CWSW_ALARMSTATIC__R16(M, (2*(k)+1), a)
+#define CWSW_ALARMSTATIC__R64(M, k, a)		CWSW_ALARMSTATIC__R32(M, (2*(k)), a) CWSW_ALARMSTATIC__R32(M, (2*(k)+1), a)
+#define CWSW_ALARMSTATIC__R128(M, k, a)		CWSW_ALARMSTATIC__R64(M, (2*(k)), a) CWSW_ALARMSTATIC__R64(M, (2*(k)+1), a)
+#define CWSW_ALARMSTATIC__R256(M, k, a)		CWSW_ALARMSTATIC__R128(M, (2*(k)), a) CWSW_ALARMSTATIC__R128(M, (2*(k)+1), a)
+
+#if (CWSW_ALARMSTATIC_MAX_FRAMES == 16)
+#define CWSW_ALARMSTATIC__REPEAT			CWSW_ALARMSTATIC__R16
+#elif (CWSW_ALARMSTATIC_MAX_FRAMES == 32)
+#define CWSW_ALARMSTATIC__REPEAT			CWSW_ALARMSTATIC__R32
+#elif (CWSW_ALARMSTATIC_MAX_FRAMES == 64)
+#define CWSW_ALARMSTATIC__REPEAT			CWSW_ALARMSTATIC__R64
+#elif (CWSW_ALARMSTATIC_MAX_FRAMES == 128)
+#define CWSW_ALARMSTATIC__REPEAT			CWSW_ALARMSTATIC__R128
+#elif (CWSW_ALARMSTATIC_MAX_FRAMES == 256)
+#define CWSW_ALARMSTATIC__REPEAT			CWSW_ALARMSTATIC__R256
+#else
+#error "CWSW_ALARMSTATIC_MAX_FRAMES must be one of 16, 32, 64, 128 or 256."
+#endif
+//! @}
+
+// ---- Targets for Get/Set APIs -------------------------------------------- {
+
+/** "Chapter Designator" for Get/Set API.
+ *	Intentionally unused symbol, designed to get you to the correct starting
+ *	point, when you want to find macros for the Get/Set API; simply highlight
+ *	the Module argument in your IDE (e.g, Eclipse, NetBeans, etc.), and select
+ *	Go To Definition.
+ */
+enum { Cwsw_SwAlarmStatic };	/* Component ID for Static Alarm Schedule */
+
+// ---- /Targets for Get/Set APIs ------------------------------------------- }
+
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* CWSW_ALARMSTATIC_H */
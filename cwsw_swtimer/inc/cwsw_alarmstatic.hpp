@@ -0,0 +1,107 @@
+/** @file
+ *	@brief	CWSW Static Alarm Schedule: C++ constexpr front end.
+ *
+ *	Builds the same ROM schedule as CWSW_ALARMSTATIC_DEFINE(), but the compiler works out the minor
+ *	frame (the GCD of every period and phase) and the hyperperiod (the LCM of the periods), and the
+ *	slot table is sized to the hyperperiod exactly. Requires C++17.
+ *
+ *		constexpr tCwswSwAlarmStaticEntry kManaged[] = {
+ *			{ CWSW_CLOCK_MS(10),	0,					evSample },
+ *			{ CWSW_CLOCK_MS(100),	CWSW_CLOCK_MS(20),	evReport },
+ *			{ CWSW_CLOCK_MS(500),	CWSW_CLOCK_MS(50),	evBlink },
+ *		};
+ *		using tManaged = cwsw::StaticAlarmSchedule<kManaged>;
+ *		constexpr tCwswSwAlarmStaticTable kSchedule = tManaged::Table(&osq);
+ *		tCwswSwAlarmStatic tedlos = { &kSchedule };
+ *
+ *	The run-time state and API are those of cwsw_alarmstatic.h.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef CWSW_ALARMSTATIC_HPP
+#define CWSW_ALARMSTATIC_HPP
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>		/* std::gcd, std::lcm */
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "cwsw_alarmstatic.h"
+
+
+namespace cwsw {
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/**	Static schedule of the alarms listed in `Entries`, a constexpr array of tCwswSwAlarmStaticEntry.
+ *	Alarms due in the same frame are posted in the order listed.
+ */
+template <const auto &Entries>
+struct StaticAlarmSchedule {
+	static constexpr std::size_t count = std::size(Entries);
+
+	/**	Tics per minor frame: the largest span of which every period and phase is a multiple. */
+	static constexpr tCwswClockTics minor = [] {
+		tCwswClockTics g = 0;
+		for(const auto &e : Entries)	{ g = std::gcd(std::gcd(g, e.period), e.phase); }
+		return g;
+	}();
+
+	/**	Tics after which the schedule repeats. */
+	static constexpr tCwswClockTics hyperperiod = [] {
+		tCwswClockTics h = 1;
+		for(const auto &e : Entries)	{ h = std::lcm(h, e.period); }
+		return h;
+	}();
+
+	static constexpr std::size_t nframes = static_cast<std::size_t>(hyperperiod / minor);
+
+	static_assert((count > 0) && (count <= kSwAlarmStatic_MaxAlarms), "A static alarm schedule holds 1 to 32 alarms.");
+	static_assert([] {
+		for(const auto &e : Entries)	{ if((e.period <= 0) || (e.phase < 0) || (e.phase >= e.period))	{ return false; } }
+		return true;
+	}(), "Every period must be positive, and every phase less than its period.");
+	static_assert(nframes <= UINT16_MAX, "Too many minor frames in the hyperperiod.");
+
+	/**	Per minor frame, a bit for each alarm due in it. */
+	static constexpr std::array<uint32_t, nframes> slots = [] {
+		std::array<uint32_t, nframes> s {};
+		for(std::size_t i = 0; i < count; ++i)
+		{
+			for(tCwswClockTics t = Entries[i].phase; t < hyperperiod; t += Entries[i].period)
+			{
+				s[static_cast<std::size_t>(t / minor)] |= (1UL << i);
+			}
+		}
+		return s;
+	}();
+
+	/**	The ROM schedule, posting to the given queue. */
+	static constexpr tCwswSwAlarmStaticTable
+	Table(ptEvQ_QueueCtrlEx pEvQX)
+	{
+		return tCwswSwAlarmStaticTable {
+			Entries, slots.data(), pEvQX, minor, hyperperiod,
+			static_cast<uint16_t>(nframes), static_cast<uint8_t>(count)
+		};
+	}
+};
+
+} // namespace cwsw
+
+#endif /* CWSW_ALARMSTATIC_HPP */
@@ -0,0 +1,121 @@
+/** @file
+ *	@brief	CWSW SW Alarm Table (structure-of-arrays alarm storage).
+ *
+ *	An alarm table splits the fields of a set of alarms by how often they're touched. Deadlines live
+ *	in one dense array and enable flags in a bitset, so the expiry scan streams through only the
+ *	data it needs; the remaining ("cold") fields stay in ordinary tCwswSwAlarm records, which are
+ *	visited only for alarms that have matured.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef CWSW_ALARMTABLE_H
+#define CWSW_ALARMTABLE_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdint.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_clock.h"		/* tCwswClockTics */
+
+// ----	Module Headers --------------------------
+#include "cwsw_swtimer.h"	/* tCwswSwAlarm */
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/**	Vector expiry scan. When nonzero, scans use SSE2 or AVX2 wherever the compiler targets them;
+ *	zero selects the scalar scan everywhere (e.g., to check the two against each other).
+ */
+#if !defined(CWSW_ALARMTABLE_SIMD)
+#define CWSW_ALARMTABLE_SIMD		1
+#endif
+
+enum { kSwAlarmTable_BitsPerWord = 32 };	//!< Alarms per word of the enable and matured bitsets.
+
+/**	Number of bitset words needed for a table of `n` alarms. */
+#define CWSW_ALARMTABLE_WORDS(n)	(((n) + kSwAlarmTable_BitsPerWord - 1) / kSwAlarmTable_BitsPerWord)
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/**	SW Alarm Table.
+ *	As with other CWSW tables, the storage is supplied by the caller and this is its metadata.
+ *	Entry `i` of each array describes the same alarm. While an alarm belongs to a table, the
+ *	authoritative copy of its deadline and enabled state is held by the table, not by the record.
+ *	The table's functions may be called from an alarm's own callback, as it matures.
+ */
+typedef struct sCwswSwAlarmTable {
+	tCwswClockTics		*pDeadlines;	/**< Hot: deadline of each alarm, as a raw clock tic. */
+	uint32_t			*pEnabled;		/**< Hot: enable bitset; CWSW_ALARMTABLE_WORDS(capacity) words. */
+	uint32_t			*pMatured;		/**< Output of the last scan; CWSW_ALARMTABLE_WORDS(capacity) words. */
+	ptCwswSwAlarm		pAlarms;		/**< Cold: reload time, event binding, rearm policy. */
+	uint32_t			capacity;		/**< Number of alarms in the table. */
+	ptCwswSwAlarmBatch	pBatch;			/**< Optional batch for event delivery; see Cwsw_SwAlarm__InitBatch(). */
+	tCwswClockTics		scantm;			/**< Tic tested by the last scan; dispatch services alarms at this tic. */
+	ptCwswSwAlarm		pMaturing;		/**< Periodic alarm being dispatched; its record holds its new deadline. */
+} tCwswSwAlarmTable, *ptCwswSwAlarmTable;
+
+
+// ============================================================================
+// ----	Public Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+// ---- Discrete Functions -------------------------------------------------- {
+
+extern tErrorCodes_SwTmr Cwsw_SwAlarmTable__Init(
+	ptCwswSwAlarmTable	pTbl,
+	tCwswClockTics		*pDeadlines,
+	uint32_t			*pEnabled,
+	uint32_t			*pMatured,
+	ptCwswSwAlarm		pAlarms,
+	uint32_t			capacity);
+extern tErrorCodes_SwTmr Cwsw_SwAlarmTable__Arm(ptCwswSwAlarmTable pTbl, uint32_t idx, tCwswClockTics duration);
+extern void Cwsw_SwAlarmTable__Disable(ptCwswSwAlarmTable pTbl, uint32_t idx);
+extern void Cwsw_SwAlarmTable__Pause(ptCwswSwAlarmTable pTbl, uint32_t idx);
+extern void Cwsw_SwAlarmTable__Resume(ptCwswSwAlarmTable pTbl, uint32_t idx);
+extern uint32_t Cwsw_SwAlarmTable__Scan(ptCwswSwAlarmTable pTbl, tCwswClockTics now);
+extern uint32_t Cwsw_SwAlarmTable__Dispatch(ptCwswSwAlarmTable pTbl);
+extern uint32_t Cwsw_SwAlarmTable__Task(ptCwswSwAlarmTable pTbl);
+
+// ---- /Discrete Functions ------------------------------------------------- }
+
+// ---- Targets for Get/Set APIs -------------------------------------------- {
+
+/** "Chapter Designator" for Get/Set API.
+ *	Intentionally unused symbol, designed to get you to the correct starting
+ *	point, when you want to find macros for the Get/Set API; simply highlight
+ *	the Module argument in your IDE (e.g, Eclipse, NetBeans, etc.), and select
+ *	Go To Definition.
+ */
+enum { Cwsw_SwAlarmTable };	/* Component ID for SW Alarm Table */
+
+// ---- /Targets for Get/Set APIs ------------------------------------------- }
+
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* CWSW_ALARMTABLE_H */
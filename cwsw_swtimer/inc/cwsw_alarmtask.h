@@ -0,0 +1,170 @@
+/** @file
+ *	@brief	CWSW SW Alarm Tasks: periodic tasks dispatched by priority or by deadline.
+ *
+ *	Each task is a periodic alarm plus the function it runs. When a task's alarm matures, it
+ *	releases a job; ready jobs are then run one at a time, most urgent first: by rate-monotonic
+ *	priority (shorter period first), or earliest deadline first. So a 1 ms control task released
+ *	alongside a 1 s housekeeping task runs first, whatever order their alarms matured in.
+ *
+ *	Dispatch is cooperative: a job, once started, runs to completion. Each task has an execution
+ *	budget; a job that runs past it is reported, as is every job that completes after its deadline
+ *	or is released over before it could run. Run one job per pass through the main loop, between
+ *	calls to Cwsw_ClockSvc__Task(), and a long job delays urgent work by no more than its own
+ *	length.
+ *
+ *	Meant for dozens of tasks: choosing the next job is a scan of the scheduler's tasks.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef CWSW_ALARMTASK_H
+#define CWSW_ALARMTASK_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdint.h>
+#include <stdbool.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_clock.h"			/* tCwswClockTics */
+
+// ----	Module Headers --------------------------
+#include "cwsw_alarmsched.h"	/* tCwswSwAlarmSched */
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/**	Order in which ready jobs run. */
+enum eSwAlarmTaskPolicy {
+	kSwAlarmTask_RateMonotonic,		//!< Fixed priority: shorter period first; then shorter deadline, then order added.
+	kSwAlarmTask_EarliestDeadline	//!< Earliest absolute deadline first; ties as for rate-monotonic.
+};
+
+/**	Kinds of timing fault reported for a job. */
+enum eSwAlarmTaskMiss {
+	kSwAlarmTaskMiss_Deadline,		//!< Completed after its deadline. excess: ns late.
+	kSwAlarmTaskMiss_Released,		//!< Never ran: the next release (or several) came first. excess: jobs lost.
+	kSwAlarmTaskMiss_Budget			//!< Ran longer than its budget. excess: ns over.
+};
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+typedef enum eSwAlarmTaskPolicy tSwAlarmTaskPolicy;
+typedef enum eSwAlarmTaskMiss tSwAlarmTaskMiss;
+
+struct sCwswSwAlarmTask;
+
+/**	A task's job function. */
+typedef void (*pfCwswSwAlarmTaskFn)(struct sCwswSwAlarmTask *pTask, void *pCtx);
+
+/**	Handler for timing faults; called from the dispatcher, after the job concerned. */
+typedef void (*pfCwswSwAlarmTaskMiss)(struct sCwswSwAlarmTask *pTask, tSwAlarmTaskMiss kind, uint64_t excess, void *pCtx);
+
+/**	Timing record of one task. */
+typedef struct sCwswSwAlarmTaskStats {
+	uint32_t	jobs;			/**< Jobs run. */
+	uint32_t	misses;			/**< Jobs that completed late, or never ran. */
+	uint32_t	overruns;		/**< Jobs that ran past the budget. */
+	uint64_t	maxexecns;		/**< Longest job, in ns. */
+	uint64_t	maxlatens;		/**< Longest from release to start of a job, in ns. */
+} tCwswSwAlarmTaskStats, *ptCwswSwAlarmTaskStats;
+
+/**	One periodic task.
+ *	The alarm, job state and linkage belong to the scheduler once the task is added.
+ */
+typedef struct sCwswSwAlarmTask {
+	tCwswSwAlarm			alarm;		/**< Releases the task's jobs. */
+	pfCwswSwAlarmTaskFn		pfnRun;
+	void					*pCtx;		/**< Context for pfnRun. */
+	tCwswClockTics			period;		/**< Tics between releases. */
+	tCwswClockTics			deadline;	/**< Tics from release by which a job must complete; at most `period`. */
+	uint64_t				budgetns;	/**< Execution budget per job, in ns; 0 for none. */
+	uint16_t				id;			/**< Caller's identifier, for reports. */
+
+	// job state
+	bool					ready;		/**< A job is released and waiting to run. */
+	tCwswClockTics			release;	/**< Release tic of the waiting job. */
+	tCwswClockTics			due;		/**< Absolute deadline of the waiting job. */
+	uint32_t				order;		/**< Order added; last tie-breaker. */
+	tCwswSwAlarmTaskStats	stats;
+	struct sCwswSwAlarmTaskSched	*pSched;	/**< Scheduler the task belongs to; NULL if none. */
+	struct sCwswSwAlarmTask	*pNext;		/**< Next task of the same scheduler. */
+} tCwswSwAlarmTask, *ptCwswSwAlarmTask;
+
+/**	Task scheduler: the alarms that release jobs, and the tasks that run them. */
+typedef struct sCwswSwAlarmTaskSched {
+	tCwswSwAlarmSched		alarms;
+	ptCwswSwAlarmTask		pTasks;
+	tSwAlarmTaskPolicy		policy;
+	uint32_t				nextorder;
+	pfCwswSwAlarmTaskMiss	pfnMiss;	/**< Timing fault handler; NULL for none. */
+	void					*pMissCtx;
+} tCwswSwAlarmTaskSched, *ptCwswSwAlarmTaskSched;
+
+
+// ============================================================================
+// ----	Public Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+// ---- Discrete Functions -------------------------------------------------- {
+
+extern tErrorCodes_SwTmr Cwsw_SwAlarmTask__InitSched(ptCwswSwAlarmTaskSched pSched, tSwAlarmTaskPolicy policy);
+extern void Cwsw_SwAlarmTask__SetMissHandler(ptCwswSwAlarmTaskSched pSched, pfCwswSwAlarmTaskMiss pfnMiss, void *pCtx);
+
+extern tErrorCodes_SwTmr Cwsw_SwAlarmTask__Init(
+	ptCwswSwAlarmTask		pTask,
+	pfCwswSwAlarmTaskFn		pfnRun,
+	void					*pCtx,
+	tCwswClockTics			period,
+	tCwswClockTics			deadline,
+	uint64_t				budgetns,
+	uint16_t				id);
+extern tErrorCodes_SwTmr Cwsw_SwAlarmTask__Add(ptCwswSwAlarmTaskSched pSched, ptCwswSwAlarmTask pTask, tCwswClockTics phase);
+extern void Cwsw_SwAlarmTask__Remove(ptCwswSwAlarmTask pTask);
+extern void Cwsw_SwAlarmTask__GetStats(ptCwswSwAlarmTask pTask, ptCwswSwAlarmTaskStats pStats, bool reset);
+
+extern ptCwswSwAlarmTask Cwsw_SwAlarmTask__Dispatch(ptCwswSwAlarmTaskSched pSched);
+extern uint32_t Cwsw_SwAlarmTask__Task(ptCwswSwAlarmTaskSched pSched);
+extern bool Cwsw_SwAlarmTask__NextWake(ptCwswSwAlarmTaskSched pSched, pCwswClockTics pTic);
+
+// ---- /Discrete Functions ------------------------------------------------- }
+
+// ---- Targets for Get/Set APIs -------------------------------------------- {
+
+/** "Chapter Designator" for Get/Set API.
+ *	Intentionally unused symbol, designed to get you to the correct starting
+ *	point, when you want to find macros for the Get/Set API; simply highlight
+ *	the Module argument in your IDE (e.g, Eclipse, NetBeans, etc.), and select
+ *	Go To Definition.
+ */
+enum { Cwsw_SwAlarmTask };	/* Component ID for SW Alarm Tasks */
+
+// ---- /Targets for Get/Set APIs ------------------------------------------- }
+
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* CWSW_ALARMTASK_H */
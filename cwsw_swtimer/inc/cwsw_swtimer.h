@@ -20,6 +20,7 @@
 // ----	Project Headers -------------------------
 #include "cwsw_lib.h"		/* kErr_Lib_NoError */
 #include "cwsw_clock.h"		/* tCwswClockTics */
+#include "cwsw_tichist.h"	/* tCwswTicHist */
 
 // ----	Module Headers --------------------------
 
@@ -35,22 +36,27 @@ extern "C" {
 
 /** Common values for timers and alarms. */
 enum eSwTimerCommonValues {
-	tmr1ms	  =	   1 / Cwsw_ClockSvc_TicResolution,		//!<    1 ms. @note This is the native tic rate.
-	tmr5ms	  =    5 / Cwsw_ClockSvc_TicResolution,		//!<    5 ms
-	tmr10ms   =   10 / Cwsw_ClockSvc_TicResolution,		//!<   10 ms
-	tmr20ms   =   20 / Cwsw_ClockSvc_TicResolution,		//!<   20 ms
-	tmr25ms   =   25 / Cwsw_ClockSvc_TicResolution,		//!<   25 ms
-	tmr50ms   =   50 / Cwsw_ClockSvc_TicResolution,		//!<   50 ms
-	tmr100ms  =  100 / Cwsw_ClockSvc_TicResolution,		//!<  100 ms
-	tmr250ms  =  250 / Cwsw_ClockSvc_TicResolution,		//!<  250 ms
-	tmr500ms  =  500 / Cwsw_ClockSvc_TicResolution,		//!<  500 ms
-	tmr1000ms = 1000 / Cwsw_ClockSvc_TicResolution,		//!< 1000 ms
+	tmr1ms	  =	CWSW_CLOCK_MS(1),		//!<    1 ms. @note This is the native tic rate by default.
+	tmr5ms	  =	CWSW_CLOCK_MS(5),		//!<    5 ms
+	tmr10ms   =	CWSW_CLOCK_MS(10),		//!<   10 ms
+	tmr20ms   =	CWSW_CLOCK_MS(20),		//!<   20 ms
+	tmr25ms   =	CWSW_CLOCK_MS(25),		//!<   25 ms
+	tmr50ms   =	CWSW_CLOCK_MS(50),		//!<   50 ms
+	tmr100ms  =	CWSW_CLOCK_MS(100),		//!<  100 ms
+	tmr250ms  =	CWSW_CLOCK_MS(250),		//!<  250 ms
+	tmr500ms  =	CWSW_CLOCK_MS(500),		//!<  500 ms
+	tmr1000ms =	CWSW_CLOCK_MS(1000),	//!< 1000 ms
 };
 
 enum eErrorCodes_SwTmr {
 	kErr_SwTmr_NoError = kErr_Lib_NoError,
 	kErr_SwTmr_NotInitialized,
 	kErr_SwTmr_BadParm,			//!< Bad Parameter; e.g., NULL pointer-to-event.
+	kErr_SwTmr_PostFailed,		//!< One or more alarm events could not be posted to their event queue.
+	kErr_SwTmr_Full,			//!< No room to accept the request; try again later.
+	kErr_SwTmr_StaleHandle,		//!< Alarm handle does not (or no longer) refer to an alarm in use.
+	kErr_SwTmr_Io,				//!< A snapshot file could not be created, mapped, synced or renamed.
+	kErr_SwTmr_BadSnapshot,		//!< Snapshot is damaged, of another format or tic length, or doesn't match the alarm set.
 };
 
 /**	Enabled/disabled states for CWSW SW Timers.
@@ -61,6 +67,27 @@ enum eSwTimerState {
 	kTmrState_Paused
 };
 
+/**	Rearm policies for periodic (repetitive) alarms.
+ *	The anchored policies compute the next deadline from the previous deadline rather than from the
+ *	time the alarm was serviced, so service latency does not accumulate as drift. They differ only
+ *	in how they react when service falls more than one period behind.
+ */
+enum eSwAlarmRearm {
+	kSwAlarmRearm_FromService,	//!< Next deadline is service time + reload. Legacy behavior; period drifts by service latency.
+	kSwAlarmRearm_SkipMissed,	//!< Anchored. Periods missed entirely are skipped; one event is posted.
+	kSwAlarmRearm_PostEach,		//!< Anchored. One event is posted for each period that matured, carrying that period's deadline.
+	kSwAlarmRearm_PostCount		//!< Anchored. One event is posted; its data carries the number of periods that matured.
+};
+
+
+/**	Histograms kept by SW alarms, when CWSW_CLOCK_HISTOGRAMS is enabled. */
+enum eSwAlarmHist {
+	kSwAlarmHist_Lateness,		//!< Tics between an alarm's deadline and its maturation being serviced.
+	kSwAlarmHist_PostNs,		//!< Nanoseconds spent posting one alarm event; monotonic clock backend only.
+	kSwAlarmHist_CallbackNs,	//!< Nanoseconds from an alarm's deadline to the start of its callback; monotonic clock backend only.
+	kNumSwAlarmHist
+};
+
 
 // ============================================================================
 // ----	Type Definitions ------------------------------------------------------
@@ -72,10 +99,25 @@ typedef enum eErrorCodes_SwTmr tErrorCodes_SwTmr;
  */
 typedef enum eSwTimerState tSwTimerState;
 
+/**	Rearm policy for periodic alarms. */
+typedef enum eSwAlarmRearm tSwAlarmRearm;
+
+struct sSwTimer;
+struct sCwswSwAlarmGroup;
+
+/**	Callback run inline when an alarm matures, in place of posting its event.
+ *	@param [in,out]	pAlarm	The alarm that matured; already rearmed, if periodic.
+ *	@param [in]		evdata	What the event's data would have been (deadline, or period count,
+ *							according to the alarm's rearm policy).
+ *	@param [in]		pCtx	Context registered with the callback.
+ */
+typedef void (*pfCwswSwAlarmCallback)(struct sSwTimer *pAlarm, uint32_t evdata, void *pCtx);
+
 /**	CWSW SW Timer.
  */
 typedef struct sSwTimer {
-	tCwswClockTics		tm;			/**< Current # of tics left before expiration.
+	tCwswClockTics		tm;			/**< Deadline, as a raw clock tic; while paused, the # of tics
+									 * left before expiration.
 									 * @note We want this to be the 1st field, on the thinking that
 									 * this will result in correct operation if an object of this
 									 * type is passed to the clock services APIs.
@@ -86,8 +128,40 @@ typedef struct sSwTimer {
 									 * This is a generic container so any event class can be used; 0 for no event.
 									 */
 	tSwTimerState		tmrstate;	/**< Current timer state. */
+	tSwAlarmRearm		rearm;		/**< How a periodic alarm computes its next deadline. */
+	tCwswClockTics		slack;		/**< Tics the alarm may mature after its deadline, so the
+									 *	 scheduler can coalesce it with its neighbors; 0 for exact.
+									 */
+	pfCwswSwAlarmCallback	pfnCallback;	/**< When set, called at maturation instead of posting to pEvQX. */
+	void				*pCtx;		/**< Context for pfnCallback. */
+
+	// scheduler linkage; owned by the alarm scheduler, never touched by the alarm APIs themselves.
+	struct sSwTimer		*pNext;		/**< Next alarm in the same scheduler slot. */
+	struct sSwTimer		**ppPrev;	/**< Address of the link that references this alarm; NULL when
+									 *	 the alarm is not registered with a scheduler.
+									 */
+	uint32_t			seq;		/**< Registration order; breaks ties between equal deadlines. */
+	struct sSwTimer		*pGroupNext;	/**< Next member of the same alarm group; see tCwswSwAlarmGroup. */
+	struct sCwswSwAlarmGroup	*pGroup;	/**< Group the alarm belongs to; NULL for none. */
 } tCwswSwAlarm, *ptCwswSwAlarm;
 
+/**	One deferred alarm event: the event, and the queue it's bound for. */
+typedef struct sSwAlarmBatchEntry {
+	ptEvQ_QueueCtrlEx	pEvQX;
+	tEvQ_Event			ev;
+} tSwAlarmBatchEntry, *ptSwAlarmBatchEntry;
+
+/**	Batch of alarm events awaiting delivery.
+ *	In keeping with other CWSW tables, this is a caller-supplied buffer plus its metadata. Events
+ *	produced while the batch is in use are collected contiguously, and delivered together by
+ *	Cwsw_SwAlarm__CommitBatch(), rather than each being posted as its alarm matures.
+ */
+typedef struct sSwAlarmBatch {
+	ptSwAlarmBatchEntry	pEntries;	/**< Caller-supplied storage. */
+	uint16_t			capacity;	/**< Number of entries in the storage. */
+	uint16_t			count;		/**< Number of entries collected, not yet committed. */
+} tCwswSwAlarmBatch, *ptCwswSwAlarmBatch;
+
 
 // ============================================================================
 // ----	Public Variables ------------------------------------------------------
@@ -108,7 +182,21 @@ extern tErrorCodes_SwTmr Cwsw_SwAlarm__Init(
 	ptEvQ_QueueCtrlEx	pEvqCtrl,	//!< Which event queue do we post an event to?
 	int16_t 			evid);
 extern void Cwsw_SwAlarm__SetState(ptCwswSwAlarm pAlarm, tSwTimerState newstate);
+extern void Cwsw_SwAlarm__SetRearmPolicy(ptCwswSwAlarm pAlarm, tSwAlarmRearm policy);
+extern void Cwsw_SwAlarm__SetSlack(ptCwswSwAlarm pAlarm, tCwswClockTics slack);
+extern void Cwsw_SwAlarm__SetCallback(ptCwswSwAlarm pAlarm, pfCwswSwAlarmCallback pfnCallback, void *pCtx);
+extern void Cwsw_SwAlarm__Pause(ptCwswSwAlarm pAlarm);
+extern void Cwsw_SwAlarm__Resume(ptCwswSwAlarm pAlarm);
 extern void Cwsw_SwAlarm__ManageTimer(ptCwswSwAlarm pAlarm);
+extern void Cwsw_SwAlarm__Mature(ptCwswSwAlarm pAlarm, ptCwswSwAlarmBatch pBatch, tCwswClockTics now);
+
+extern tErrorCodes_EvQ Cwsw_SwAlarm__Deliver(ptEvQ_QueueCtrlEx pEvQX, tEvQ_Event ev);
+extern tErrorCodes_SwTmr Cwsw_SwAlarm__InitBatch(ptCwswSwAlarmBatch pBatch, ptSwAlarmBatchEntry pEntries, uint16_t capacity);
+extern tErrorCodes_SwTmr Cwsw_SwAlarm__CommitBatch(ptCwswSwAlarmBatch pBatch);
+
+#if (CWSW_CLOCK_HISTOGRAMS)
+extern ptCwswTicHist Cwsw_SwAlarm__Histogram(enum eSwAlarmHist which);
+#endif
 
 // ---- /Discrete Functions ------------------------------------------------- }
 
@@ -0,0 +1,289 @@
+/** @file
+ *	@brief	CWSW SW Alarm Overflow: backpressure-aware delivery of alarm events.
+ *
+ *	Description:
+ *	Buffers are found by queue, on a list that only grows; a process has few queues, so the list is
+ *	short. The common case, a queue with nothing held, costs one relaxed read of the buffer's count
+ *	on top of the post; the lock is taken only to hold, retry or coalesce events. Counters of
+ *	queues without a buffer live in a buffer of no capacity, so every failed post takes one path.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <string.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_evqueue.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_alarmovf.h"
+#include "cwsw_trace.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+#if (CWSW_CLOCK_MULTICORE)
+#define OVF_LOCK(p)				while(atomic_flag_test_and_set_explicit(&(p)->lock, memory_order_acquire)) { }
+#define OVF_UNLOCK(p)			atomic_flag_clear_explicit(&(p)->lock, memory_order_release)
+#define OVF_PEEK(var)			atomic_load_explicit(&(var), memory_order_relaxed)
+#define OVF_POKE(var, val)		atomic_store_explicit(&(var), (val), memory_order_relaxed)
+#else
+#define OVF_LOCK(p)
+#define OVF_UNLOCK(p)
+#define OVF_PEEK(var)			(var)
+#define OVF_POKE(var, val)		((var) = (val))
+#endif
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Global Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+/**	Every buffer attached, most recent first. */
+static CWSW_CLOCK_SHARED(ptCwswSwAlarmOverflow)	ovf_list;
+
+/**	Counters of queues without a buffer. */
+static tCwswSwAlarmOverflow ovf_none = {
+	.policy = kSwAlarmOvf_DropNewest,
+#if (CWSW_CLOCK_MULTICORE)
+	.lock = ATOMIC_FLAG_INIT,
+#endif
+};
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/**	Index of the `n`th event held, counting from the oldest. */
+static uint16_t
+ovf_slot(const tCwswSwAlarmOverflow *pOvf, uint32_t n)
+{
+	return (uint16_t)((pOvf->head + n) % pOvf->capacity);
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+/**	Attach an overflow buffer to an event queue.
+ *	Attach before alarms start delivering to the queue; a buffer stays attached for the life of the
+ *	process, so its storage must last as long. One buffer per queue.
+ *
+ *	@param [out]	pOvf		Buffer to initialize.
+ *	@param [in]		pEvQX		Queue it serves.
+ *	@param [in]		pEvents		Storage for held events.
+ *	@param [in]		capacity	Number of events the storage holds.
+ *	@param [in]		policy		What gives way when the buffer is full.
+ *	@returns Error code, where 0 is no error.
+ */
+tErrorCodes_SwTmr
+Cwsw_SwAlarmOvf__Attach(
+	ptCwswSwAlarmOverflow	pOvf,
+	ptEvQ_QueueCtrlEx		pEvQX,
+	tEvQ_Event				*pEvents,
+	uint16_t				capacity,
+	tSwAlarmOvfPolicy		policy)
+{
+	if(!pOvf || !pEvQX || !pEvents || !capacity)		{ return kErr_SwTmr_BadParm; }
+	if(policy > kSwAlarmOvf_OverwriteOldest)			{ return kErr_SwTmr_BadParm; }
+	if(Cwsw_SwAlarmOvf__Find(pEvQX))					{ return kErr_SwTmr_BadParm; }
+
+	memset(pOvf, 0, sizeof(*pOvf));
+	pOvf->pEvQX = pEvQX;
+	pOvf->pEvents = pEvents;
+	pOvf->capacity = capacity;
+	pOvf->policy = policy;
+
+#if (CWSW_CLOCK_MULTICORE)
+	atomic_flag_clear(&pOvf->lock);
+	pOvf->pNext = atomic_load_explicit(&ovf_list, memory_order_relaxed);
+	while(!atomic_compare_exchange_weak_explicit(&ovf_list, &pOvf->pNext, pOvf,
+			memory_order_release, memory_order_relaxed))
+	{
+		// pNext has been refreshed with the current list; try again.
+	}
+#else
+	pOvf->pNext = ovf_list;
+	ovf_list = pOvf;
+#endif
+	return kErr_SwTmr_NoError;
+}
+
+
+/**	Find the overflow buffer attached to a queue.
+ *	@returns The buffer, or NULL if the queue has none.
+ */
+ptCwswSwAlarmOverflow
+Cwsw_SwAlarmOvf__Find(ptEvQ_QueueCtrlEx pEvQX)
+{
+	ptCwswSwAlarmOverflow pOvf;
+
+#if (CWSW_CLOCK_MULTICORE)
+	pOvf = atomic_load_explicit(&ovf_list, memory_order_acquire);
+#else
+	pOvf = ovf_list;
+#endif
+	while(pOvf && (pOvf->pEvQX != pEvQX))	{ pOvf = pOvf->pNext; }
+	return pOvf;
+}
+
+
+/**	Post the events held in a buffer, oldest first, until one fails or none are left.
+ *	@returns 0 if the buffer is now empty; otherwise the error code of the post that failed.
+ */
+tErrorCodes_EvQ
+Cwsw_SwAlarmOvf__Retry(ptCwswSwAlarmOverflow pOvf)
+{
+	tErrorCodes_EvQ err = (tErrorCodes_EvQ)kErr_Lib_NoError;
+	uint16_t count;
+	tEvQ_Event ev;
+
+	if(!pOvf || !OVF_PEEK(pOvf->count))	{ return err; }
+
+	OVF_LOCK(pOvf);
+	count = OVF_PEEK(pOvf->count);
+	while(count)
+	{
+		ev = pOvf->pEvents[pOvf->head];
+		err = Cwsw_EvQX__PostEvent(pOvf->pEvQX, ev);
+		if(err)	{ break; }	// still full; try again next tic
+
+		CWSW_TRACE(kCwswTrace_EvPosted, ev.evId, 0);
+		pOvf->head = ovf_slot(pOvf, 1);
+		--count;
+		++pOvf->stats.retried;
+	}
+	OVF_POKE(pOvf->count, count);
+	OVF_UNLOCK(pOvf);
+	return err;
+}
+
+
+/**	Retry the events held in every buffer. Call once per heartbeat where alarms are only polled. */
+void
+Cwsw_SwAlarmOvf__RetryAll(void)
+{
+	ptCwswSwAlarmOverflow pOvf;
+
+#if (CWSW_CLOCK_MULTICORE)
+	pOvf = atomic_load_explicit(&ovf_list, memory_order_acquire);
+#else
+	pOvf = ovf_list;
+#endif
+	for(; pOvf; pOvf = pOvf->pNext)	{ (void)Cwsw_SwAlarmOvf__Retry(pOvf); }
+}
+
+
+/**	Hold an event that could not be posted (or must wait behind events already held), according
+ *	to the buffer's policy.
+ *
+ *	@param [in,out]	pOvf	Buffer of the event's queue; NULL if the queue has none.
+ *	@param [in]		ev		Event.
+ *	@param [in]		err		Error code of the failed post.
+ *	@returns 0 if the event is held (or merged into one held); otherwise `err`, and the event is lost.
+ */
+tErrorCodes_EvQ
+Cwsw_SwAlarmOvf__Defer(ptCwswSwAlarmOverflow pOvf, tEvQ_Event ev, tErrorCodes_EvQ err)
+{
+	uint16_t count;
+	uint16_t n;
+
+	if(!pOvf)	{ pOvf = &ovf_none; }
+
+	OVF_LOCK(pOvf);
+	count = OVF_PEEK(pOvf->count);
+
+	if(pOvf->policy == kSwAlarmOvf_Coalesce)
+	{
+		for(n = 0; n < count; ++n)
+		{
+			tEvQ_Event *pHeld = &pOvf->pEvents[ovf_slot(pOvf, n)];
+
+			if(pHeld->evId == ev.evId)
+			{
+				pHeld->evData = ev.evData;
+				++pOvf->stats.coalesced;
+				OVF_UNLOCK(pOvf);
+				return (tErrorCodes_EvQ)kErr_Lib_NoError;
+			}
+		}
+	}
+
+	if(count >= pOvf->capacity)
+	{
+		if((pOvf->policy != kSwAlarmOvf_OverwriteOldest) || !pOvf->capacity)
+		{
+			++pOvf->stats.dropped;
+			OVF_UNLOCK(pOvf);
+			CWSW_TRACE(kCwswTrace_EvDropped, ev.evId, 0);
+			return err;
+		}
+
+		CWSW_TRACE(kCwswTrace_EvDropped, pOvf->pEvents[pOvf->head].evId, 0);
+		pOvf->head = ovf_slot(pOvf, 1);
+		--count;
+		++pOvf->stats.dropped;
+	}
+
+	pOvf->pEvents[ovf_slot(pOvf, count)] = ev;
+	++count;
+	++pOvf->stats.deferred;
+	if(count > pOvf->stats.maxdepth)	{ pOvf->stats.maxdepth = count; }
+	OVF_POKE(pOvf->count, count);
+	OVF_UNLOCK(pOvf);
+
+	CWSW_TRACE(kCwswTrace_EvDeferred, ev.evId, count);
+	return (tErrorCodes_EvQ)kErr_Lib_NoError;
+}
+
+
+/**	Read a buffer's counters.
+ *	@param [in,out]	pOvf	Buffer; NULL for the counters of queues without one.
+ *	@param [out]	pStats	Counters.
+ *	@param [in]		reset	Start the counters over; the depth high-water mark restarts at the
+ *							current depth.
+ */
+void
+Cwsw_SwAlarmOvf__GetStats(ptCwswSwAlarmOverflow pOvf, ptCwswSwAlarmOvfStats pStats, bool reset)
+{
+	if(!pStats)	{ return; }
+	if(!pOvf)	{ pOvf = &ovf_none; }
+
+	OVF_LOCK(pOvf);
+	*pStats = pOvf->stats;
+	if(reset)
+	{
+		memset(&pOvf->stats, 0, sizeof(pOvf->stats));
+		pOvf->stats.maxdepth = OVF_PEEK(pOvf->count);
+	}
+	OVF_UNLOCK(pOvf);
+}
+
+
+/**	Number of events a buffer holds right now. */
+uint16_t
+Cwsw_SwAlarmOvf__Depth(const tCwswSwAlarmOverflow *pOvf)
+{
+	return pOvf ? OVF_PEEK(pOvf->count) : 0;
+}
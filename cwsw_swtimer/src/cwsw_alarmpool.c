@@ -0,0 +1,219 @@
+/** @file
+ *	@brief	CWSW SW Alarm Pool: handle-based alarms for short-lived timeouts.
+ *
+ *	Description:
+ *	Free slots are kept on a singly-linked list threaded through the slots themselves (LIFO, so a
+ *	recently released slot, likely still in cache, is the next one handed out). Cancelling an
+ *	alarm unlinks it from the scheduler's wheel directly, so an alarm cancelled before it matures
+ *	costs the scheduler nothing further.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "cwsw_alarmpool.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum {
+	kSwAlarmPool_IndexMask	= (1 << kSwAlarmPool_IndexBits) - 1,
+	kSwAlarmPool_EndOfList	= kSwAlarmPool_MaxCapacity
+};
+
+#define POOL_HANDLE(gen, idx)	(((tCwswSwAlarmHandle)(gen) << kSwAlarmPool_IndexBits) | (tCwswSwAlarmHandle)(idx))
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Global Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/**	Resolve a handle to its slot.
+ *	@returns The slot, or NULL if the handle is malformed or stale.
+ */
+static ptSwAlarmPoolSlot
+pool_slot(ptCwswSwAlarmPool pPool, tCwswSwAlarmHandle hAlarm)
+{
+	uint32_t idx = hAlarm & kSwAlarmPool_IndexMask;
+	ptSwAlarmPoolSlot pSlot;
+
+	if(!pPool || (idx >= pPool->capacity))	{ return NULL; }
+
+	pSlot = &pPool->pSlots[idx];
+	return (POOL_HANDLE(pSlot->gen, idx) == hAlarm) ? pSlot : NULL;
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+/**	Initialize an alarm pool over caller-supplied slots.
+ *
+ *	@param [out]	pPool		Pool to initialize.
+ *	@param [in]		pSlots		Storage for the slots.
+ *	@param [in]		capacity	Number of slots.
+ *	@param [in]		pSched		Scheduler that will service the pool's alarms.
+ *	@returns Error code, where 0 is no error.
+ */
+tErrorCodes_SwTmr
+Cwsw_SwAlarmPool__Init(ptCwswSwAlarmPool pPool, ptSwAlarmPoolSlot pSlots, uint16_t capacity, ptCwswSwAlarmSched pSched)
+{
+	uint16_t idx;
+
+	if(!pPool || !pSlots || !capacity || !pSched)	{ return kErr_SwTmr_BadParm; }
+
+	for(idx = 0; idx < capacity; ++idx)
+	{
+		(void)Cwsw_SwAlarm__Init(&pSlots[idx].alarm, 0, 0, NULL, 0);
+		pSlots[idx].gen = 1;
+		pSlots[idx].nextfree = (uint16_t)(idx + 1);
+	}
+	pSlots[capacity - 1].nextfree = kSwAlarmPool_EndOfList;
+
+	pPool->pSlots = pSlots;
+	pPool->capacity = capacity;
+	pPool->freehead = 0;
+	pPool->nfree = capacity;
+	pPool->pSched = pSched;
+	return kErr_SwTmr_NoError;
+}
+
+
+/**	Take an alarm from the pool. The alarm starts out disarmed.
+ *
+ *	@param [in,out]	pPool	Pool.
+ *	@param [in]		pEvQX	Event queue the alarm posts to when it matures.
+ *	@param [in]		evid	Event to post; 0 for none.
+ *	@returns Handle for the alarm, or kSwAlarmPool_InvalidHandle if the pool is exhausted.
+ */
+tCwswSwAlarmHandle
+Cwsw_SwAlarmPool__Acquire(ptCwswSwAlarmPool pPool, ptEvQ_QueueCtrlEx pEvQX, int16_t evid)
+{
+	ptSwAlarmPoolSlot pSlot;
+	uint16_t idx;
+
+	if(!pPool || !pPool->nfree)		{ return kSwAlarmPool_InvalidHandle; }
+
+	idx = pPool->freehead;
+	pSlot = &pPool->pSlots[idx];
+	pPool->freehead = pSlot->nextfree;
+	--pPool->nfree;
+
+	(void)Cwsw_SwAlarm__Init(&pSlot->alarm, 0, 0, pEvQX, evid);
+	return POOL_HANDLE(pSlot->gen, idx);
+}
+
+
+/**	Arm, or re-arm, an alarm. An alarm that is already armed is moved to its new deadline.
+ *
+ *	@param [in,out]	pPool		Pool.
+ *	@param [in]		hAlarm		Alarm.
+ *	@param [in]		duration	Timeout in tics; must be positive.
+ *	@param [in]		reloadtm	Period for a periodic alarm; 0 for a one-shot.
+ *	@returns Error code, where 0 is no error.
+ */
+tErrorCodes_SwTmr
+Cwsw_SwAlarmPool__Arm(ptCwswSwAlarmPool pPool, tCwswSwAlarmHandle hAlarm, tCwswClockTics duration, tCwswClockTics reloadtm)
+{
+	ptSwAlarmPoolSlot pSlot = pool_slot(pPool, hAlarm);
+
+	if(!pSlot)				{ return kErr_SwTmr_StaleHandle; }
+	if(reloadtm < 0)		{ return kErr_SwTmr_BadParm; }
+
+	pSlot->alarm.reloadtm = reloadtm;
+	return Cwsw_SwAlarmSched__Arm(pPool->pSched, &pSlot->alarm, duration);
+}
+
+
+/**	Disarm an alarm, keeping it for later re-arming. Cancelling a disarmed alarm is harmless. */
+tErrorCodes_SwTmr
+Cwsw_SwAlarmPool__Cancel(ptCwswSwAlarmPool pPool, tCwswSwAlarmHandle hAlarm)
+{
+	ptSwAlarmPoolSlot pSlot = pool_slot(pPool, hAlarm);
+
+	if(!pSlot)				{ return kErr_SwTmr_StaleHandle; }
+
+	Cwsw_SwAlarmSched__Cancel(pPool->pSched, &pSlot->alarm);
+	return kErr_SwTmr_NoError;
+}
+
+
+/**	Disarm an alarm and return it to the pool. The handle, and any copies of it, become stale.
+ *	May be called from the reaction to the alarm's own maturation.
+ */
+tErrorCodes_SwTmr
+Cwsw_SwAlarmPool__Release(ptCwswSwAlarmPool pPool, tCwswSwAlarmHandle hAlarm)
+{
+	ptSwAlarmPoolSlot pSlot = pool_slot(pPool, hAlarm);
+
+	if(!pSlot)				{ return kErr_SwTmr_StaleHandle; }
+
+	Cwsw_SwAlarmSched__Cancel(pPool->pSched, &pSlot->alarm);
+	if(!++pSlot->gen)		{ pSlot->gen = 1; }		// generation 0 would make handle 0 valid
+
+	pSlot->nextfree = pPool->freehead;
+	pPool->freehead = (uint16_t)(pSlot - pPool->pSlots);
+	++pPool->nfree;
+	return kErr_SwTmr_NoError;
+}
+
+
+/**	Time left before an alarm matures.
+ *
+ *	@param [in]		pPool	Pool.
+ *	@param [in]		hAlarm	Alarm.
+ *	@param [out]	pLeft	Tics remaining; 0 or negative if the deadline has arrived but the alarm
+ *							has not yet been serviced.
+ *	@returns Error code, where 0 is no error; kErr_SwTmr_NotInitialized if the alarm is not armed.
+ */
+tErrorCodes_SwTmr
+Cwsw_SwAlarmPool__Remaining(ptCwswSwAlarmPool pPool, tCwswSwAlarmHandle hAlarm, pCwswClockTics pLeft)
+{
+	ptSwAlarmPoolSlot pSlot = pool_slot(pPool, hAlarm);
+
+	if(!pSlot)				{ return kErr_SwTmr_StaleHandle; }
+	if(!pLeft)				{ return kErr_SwTmr_BadParm; }
+	if(pSlot->alarm.tmrstate != kTmrState_Enabled)	{ return kErr_SwTmr_NotInitialized; }
+
+	*pLeft = Cwsw_GetTimeLeft(pSlot->alarm.tm);
+	return kErr_SwTmr_NoError;
+}
+
+
+/**	Resolve a handle to its alarm record, for settings not covered by the pool API (e.g., the rearm
+ *	policy). The record belongs to the pool; don't retain the pointer past the alarm's release.
+ *	@returns The alarm, or NULL if the handle is stale.
+ */
+ptCwswSwAlarm
+Cwsw_SwAlarmPool__Alarm(ptCwswSwAlarmPool pPool, tCwswSwAlarmHandle hAlarm)
+{
+	ptSwAlarmPoolSlot pSlot = pool_slot(pPool, hAlarm);
+	return pSlot ? &pSlot->alarm : NULL;
+}
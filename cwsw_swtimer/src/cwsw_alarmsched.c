@@ -0,0 +1,731 @@
+/** @file
+ *	@brief	CWSW SW Alarm Scheduler (hierarchical timing wheel).
+ *
+ *	Description:
+ *	Each registered alarm is filed into one slot of a hierarchical timing wheel, chosen by how far in
+ *	the future its deadline lies. Every tic, the scheduler services exactly one slot of the innermost
+ *	level; every 2^kSwAlarmSched_SlotBits tics, one slot of the next level out is "cascaded", i.e.,
+ *	its alarms are re-filed closer in. Insertion and cancellation are O(1), and the per-tic cost is
+ *	amortized O(1) plus the number of alarms that actually mature.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <string.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_evqueue.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_alarmsched.h"
+#include "cwsw_alarmovf.h"
+#include "cwsw_trace.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Global Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/**	Slot index of a tic value within a given wheel level.
+ *	Slot math is done on the unsigned 32-bit image of the tic, which is consistent across counter
+ *	rollover because the span of the wheel divides 2^32.
+ */
+#define SLOT_OF(tm, level)	((uint32_t)(((uint32_t)(tm)) >> ((level) * kSwAlarmSched_SlotBits)) & kSwAlarmSched_SlotMask)
+
+/**	Count trailing zeros of a nonzero 64-bit word. */
+static uint32_t
+sched_ctz64(uint64_t w)
+{
+#if defined(__GNUC__)
+	return (uint32_t)__builtin_ctzll(w);
+#else
+	uint32_t n = 0;
+	while(!(w & 1))	{ w >>= 1; ++n; }
+	return n;
+#endif
+}
+
+/**	Note that a list head may have become empty.
+ *	If `ppHead` is one of the wheel's slots and the slot is now empty, clear its occupancy bit;
+ *	list links elsewhere (the due list, a detached local list, an alarm's `pNext`) are ignored.
+ */
+static void
+sched_mark_empty(ptCwswSwAlarmSched pSched, ptCwswSwAlarm *ppHead)
+{
+	uintptr_t offset = (uintptr_t)ppHead - (uintptr_t)&pSched->wheel[0][0];
+	uint32_t idx;
+
+	if(*ppHead || (offset >= sizeof(pSched->wheel)))	{ return; }
+
+	idx = (uint32_t)(offset / sizeof(pSched->wheel[0][0]));
+	pSched->occupied[idx / kSwAlarmSched_Slots] &= ~((uint64_t)1 << (idx % kSwAlarmSched_Slots));
+}
+
+static void
+sched_link(ptCwswSwAlarm *ppHead, ptCwswSwAlarm pAlarm)
+{
+	pAlarm->pNext = *ppHead;
+	if(pAlarm->pNext)	{ pAlarm->pNext->ppPrev = &pAlarm->pNext; }
+	*ppHead = pAlarm;
+	pAlarm->ppPrev = ppHead;
+}
+
+static void
+sched_unlink(ptCwswSwAlarmSched pSched, ptCwswSwAlarm pAlarm)
+{
+	ptCwswSwAlarm *ppPrev = pAlarm->ppPrev;
+
+	*ppPrev = pAlarm->pNext;
+	if(pAlarm->pNext)	{ pAlarm->pNext->ppPrev = ppPrev; }
+	pAlarm->pNext = NULL;
+	pAlarm->ppPrev = NULL;
+	sched_mark_empty(pSched, ppPrev);
+}
+
+/**	Move a whole list onto a local head, so it can be walked while the original list is refilled. */
+static ptCwswSwAlarm
+sched_detach(ptCwswSwAlarmSched pSched, ptCwswSwAlarm *ppHead)
+{
+	ptCwswSwAlarm list = *ppHead;
+
+	*ppHead = NULL;
+	sched_mark_empty(pSched, ppHead);
+	return list;
+}
+
+/**	Sort a detached list into registration order (insertion sort; slot lists are short). */
+static ptCwswSwAlarm
+sched_sort(ptCwswSwAlarm list)
+{
+	ptCwswSwAlarm sorted = NULL;
+	ptCwswSwAlarm pAlarm;
+	ptCwswSwAlarm *ppLink;
+
+	while((pAlarm = list) != NULL)
+	{
+		list = pAlarm->pNext;
+		for(ppLink = &sorted; *ppLink && ((int32_t)((*ppLink)->seq - pAlarm->seq) < 0); ppLink = &(*ppLink)->pNext)
+		{
+			// find the first alarm registered after this one.
+		}
+		pAlarm->pNext = *ppLink;
+		*ppLink = pAlarm;
+	}
+	return sorted;
+}
+
+/**	Tic at which an alarm is to mature: its deadline, or, for an alarm with slack, the tic in its
+ *	window [deadline, deadline + slack] that is a multiple of the largest power of 2.
+ *	That tic depends only on the window, so alarms whose windows overlap tend to land on the same
+ *	tic, and each coarser boundary gathers more of them.
+ */
+static tCwswClockTics
+sched_due_tic(const tCwswSwAlarm *pAlarm)
+{
+	uint64_t lo = (uint64_t)pAlarm->tm;
+	uint64_t hi = lo + (uint64_t)pAlarm->slack;
+	uint64_t diff = lo ^ hi;
+	uint32_t msb = 0;
+
+	if((pAlarm->slack <= 0) || (hi < lo))	{ return pAlarm->tm; }
+
+	// lo and hi agree above their highest differing bit, where hi has a 1 and lo a 0; so hi with
+	//	the bits below that cleared is the most-aligned tic in the window.
+#if defined(__GNUC__)
+	msb = 63U - (uint32_t)__builtin_clzll(diff);
+#else
+	while(diff >>= 1)	{ ++msb; }
+#endif
+	return (tCwswClockTics)(hi & ~(((uint64_t)1 << msb) - 1));
+}
+
+/**	File an alarm into the wheel according to the distance between its due tic and the last
+ *	serviced tic. Alarms whose deadline has already arrived go onto the "due" list, except while
+ *	cascading, when an alarm due at this very tic goes into the level-0 slot about to be serviced,
+ *	alongside any others due at the same tic.
+ */
+static void
+sched_file(ptCwswSwAlarmSched pSched, ptCwswSwAlarm pAlarm, bool cascading)
+{
+	tCwswClockTics slottm = sched_due_tic(pAlarm);
+	tCwswClockTics delta = Cwsw_ElapsedTimeMs(pSched->curtic, slottm);
+	tCwswClockTics span = kSwAlarmSched_Slots;
+	uint32_t slot;
+	int level = 0;
+
+	if((delta < 0) || ((delta == 0) && !cascading))
+	{
+		sched_link(&pSched->pDue, pAlarm);
+		return;
+	}
+
+	while((level < kSwAlarmSched_Levels - 1) && (delta >= span))
+	{
+		++level;
+		span <<= kSwAlarmSched_SlotBits;
+	}
+
+	// beyond the reach of the wheel: park in the farthest slot of the outermost level. when that
+	//	slot is cascaded, the alarm is re-filed against its real due tic.
+	if(delta >= span)	{ slottm = Cwsw_TicsAfter(pSched->curtic, span - 1); }
+
+	slot = SLOT_OF(slottm, level);
+	sched_link(&pSched->wheel[level][slot], pAlarm);
+	pSched->occupied[level] |= ((uint64_t)1 << slot);
+}
+
+/**	Re-file every alarm in one slot of an outer level. */
+static void
+sched_cascade(ptCwswSwAlarmSched pSched, int level, uint32_t slot)
+{
+	ptCwswSwAlarm pAlarm;
+	ptCwswSwAlarm pending = sched_detach(pSched, &pSched->wheel[level][slot]);
+
+	if(pending)	{ pending->ppPrev = &pending; }
+
+	while((pAlarm = pending) != NULL)
+	{
+		sched_unlink(pSched, pAlarm);
+		sched_file(pSched, pAlarm, true);
+	}
+}
+
+/**	Distance from the last serviced tic to the next tic at which an occupied slot of an outer level
+ *	is cascaded, or 0 if no outer level holds any alarms.
+ *	Until then, only alarms already in level 0 can mature.
+ */
+static uint32_t
+sched_next_cascade(ptCwswSwAlarmSched pSched)
+{
+	uint32_t tic = (uint32_t)pSched->curtic;
+	uint32_t nearest = 0;
+	uint32_t dist;
+	uint32_t shift;
+	uint32_t rot;
+	uint64_t occupied;
+	int level;
+
+	for(level = 1; level < kSwAlarmSched_Levels; ++level)
+	{
+		occupied = pSched->occupied[level];
+		if(!occupied)	{ continue; }
+
+		// rotate the occupancy so that bit 0 is the slot cascaded next at this level.
+		shift = (uint32_t)level * kSwAlarmSched_SlotBits;
+		rot = (SLOT_OF(tic, level) + 1) & kSwAlarmSched_SlotMask;
+		if(rot)	{ occupied = (occupied >> rot) | (occupied << (kSwAlarmSched_Slots - rot)); }
+
+		dist = ((((tic >> shift) + sched_ctz64(occupied) + 1) << shift) - tic);
+		if(!nearest || (dist < nearest))	{ nearest = dist; }
+	}
+	return nearest;
+}
+
+/**	Mature every alarm on one (detached) list.
+ *	Alarms which rearm, and any alarms (re)registered as a side effect of maturation, land in fresh
+ *	slots rather than the list being walked. Alarms that are no longer enabled are quietly dropped
+ *	from the scheduler.
+ *	@returns Number of alarms that matured.
+ */
+static uint32_t
+sched_expire(ptCwswSwAlarmSched pSched, ptCwswSwAlarm pending, tCwswClockTics now)
+{
+	uint32_t fired = 0;
+	ptCwswSwAlarm pAlarm;
+
+	if(pSched->ordered)	{ pending = sched_sort(pending); }
+	if(pending)			{ pending->ppPrev = &pending; }
+	for(pAlarm = pending; pAlarm && pAlarm->pNext; pAlarm = pAlarm->pNext)
+	{
+		pAlarm->pNext->ppPrev = &pAlarm->pNext;
+	}
+
+	while((pAlarm = pending) != NULL)
+	{
+		sched_unlink(pSched, pAlarm);
+		--pSched->nalarms;
+
+		if(pAlarm->tmrstate != kTmrState_Enabled)	{ continue; }
+
+		Cwsw_SwAlarm__Mature(pAlarm, pSched->pBatch, now);
+		++fired;
+
+		// periodic alarms have already been rearmed; put them back on the wheel.
+		if((pAlarm->reloadtm > 0) && (pAlarm->tmrstate == kTmrState_Enabled) && !pAlarm->ppPrev)
+		{
+			pAlarm->seq = pSched->nextseq++;
+			sched_file(pSched, pAlarm, false);
+			++pSched->nalarms;
+		}
+	}
+	return fired;
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+/**	Initialize an alarm scheduler.
+ *	The scheduler starts out empty, synchronized to the current clock tic.
+ *
+ *	@param [out] pSched	Scheduler to initialize.
+ *	@returns Error code, where 0 is no error.
+ */
+tErrorCodes_SwTmr
+Cwsw_SwAlarmSched__Init(ptCwswSwAlarmSched pSched)
+{
+	if(!pSched)		{ return kErr_SwTmr_BadParm; }
+
+	memset(pSched, 0, sizeof(*pSched));
+	pSched->curtic = Cwsw_ClockSvc__TimerTic();
+	return kErr_SwTmr_NoError;
+}
+
+
+/**	Register an alarm with the scheduler, against the deadline already held in the alarm.
+ *	An alarm that is already registered is first removed, so this also serves to re-file an alarm
+ *	whose deadline has been changed by the caller.
+ *
+ *	The alarm's state is not changed; an alarm that is not enabled when its deadline arrives is
+ *	dropped from the scheduler without maturing.
+ *
+ *	@param [in,out] pSched	Scheduler.
+ *	@param [in,out] pAlarm	Alarm, previously initialized with Cwsw_SwAlarm__Init().
+ *	@returns Error code, where 0 is no error.
+ */
+tErrorCodes_SwTmr
+Cwsw_SwAlarmSched__Register(ptCwswSwAlarmSched pSched, ptCwswSwAlarm pAlarm)
+{
+	if(!pSched || !pAlarm)	{ return kErr_SwTmr_BadParm; }
+
+	if(pAlarm->ppPrev)
+	{
+		sched_unlink(pSched, pAlarm);
+		--pSched->nalarms;
+	}
+	pAlarm->seq = pSched->nextseq++;
+	sched_file(pSched, pAlarm, false);
+	++pSched->nalarms;
+	CWSW_TRACE(kCwswTrace_AlarmArmed, pAlarm->evid,
+		(Cwsw_ElapsedTimeMs(pSched->curtic, pAlarm->tm) > 0) ? Cwsw_ElapsedTimeMs(pSched->curtic, pAlarm->tm) : 0);
+	return kErr_SwTmr_NoError;
+}
+
+
+/**	Arm an alarm to mature after the given duration, enable it, and register it with the scheduler.
+ *
+ *	@param [in,out] pSched		Scheduler.
+ *	@param [in,out] pAlarm		Alarm, previously initialized with Cwsw_SwAlarm__Init().
+ *	@param [in]		duration	Timeout in timer tics; must be positive.
+ *	@returns Error code, where 0 is no error.
+ */
+tErrorCodes_SwTmr
+Cwsw_SwAlarmSched__Arm(ptCwswSwAlarmSched pSched, ptCwswSwAlarm pAlarm, tCwswClockTics duration)
+{
+	if(!pSched || !pAlarm)											{ return kErr_SwTmr_BadParm; }
+	if(Cwsw_ClockSvc__SetTimer(&pAlarm->tm, duration) != kErr_ClkSvc_NoError)	{ return kErr_SwTmr_BadParm; }
+
+	pAlarm->tmrstate = kTmrState_Enabled;
+	return Cwsw_SwAlarmSched__Register(pSched, pAlarm);
+}
+
+
+/**	Arm a periodic alarm on a fixed phase: its deadlines fall on the tics `phase` + k * `period`.
+ *	Alarms armed with the same period and phase mature on the same tics however far apart they were
+ *	armed, so they are serviced together. The first deadline is the first such tic after the
+ *	current tic. To hold the phase, the alarm's rearm policy must be anchored; an alarm still using
+ *	kSwAlarmRearm_FromService is switched to kSwAlarmRearm_SkipMissed.
+ *
+ *	@param [in,out] pSched	Scheduler.
+ *	@param [in,out] pAlarm	Alarm, previously initialized with Cwsw_SwAlarm__Init().
+ *	@param [in]		period	Period in tics; must be positive. Replaces the alarm's reload time.
+ *	@param [in]		phase	Any raw tic on the grid; e.g., 0 to align to multiples of the period.
+ *	@returns Error code, where 0 is no error.
+ */
+tErrorCodes_SwTmr
+Cwsw_SwAlarmSched__ArmAligned(ptCwswSwAlarmSched pSched, ptCwswSwAlarm pAlarm, tCwswClockTics period, tCwswClockTics phase)
+{
+	tCwswClockTics now = Cwsw_ClockSvc__TimerTic();
+	tCwswClockTics offset;
+
+	if(!pSched || !pAlarm || (period <= 0))	{ return kErr_SwTmr_BadParm; }
+
+	offset = Cwsw_ElapsedTimeMs(phase, now) % period;
+	if(offset < 0)	{ offset += period; }
+
+	pAlarm->tm = Cwsw_TicsAfter(now, period - offset);
+	pAlarm->reloadtm = period;
+	if(pAlarm->rearm == kSwAlarmRearm_FromService)	{ pAlarm->rearm = kSwAlarmRearm_SkipMissed; }
+	pAlarm->tmrstate = kTmrState_Enabled;
+	return Cwsw_SwAlarmSched__Register(pSched, pAlarm);
+}
+
+
+/**	Select deterministic ordering of alarms that share a deadline.
+ *	When set, alarms maturing on the same tic do so in the order they were registered (periodic
+ *	alarms count as re-registered each time they rearm); when clear, their order is unspecified.
+ */
+void
+Cwsw_SwAlarmSched__SetOrdered(ptCwswSwAlarmSched pSched, bool ordered)
+{
+	if(pSched)	{ pSched->ordered = ordered; }
+}
+
+
+/**	Select batched delivery of alarm events.
+ *	With a batch attached, events from every alarm maturing during one call to
+ *	Cwsw_SwAlarmSched__Advance() are collected contiguously and delivered together at the end of
+ *	the call (or sooner, should the batch fill). Pass NULL to revert to posting each event as its
+ *	alarm matures.
+ */
+void
+Cwsw_SwAlarmSched__SetBatch(ptCwswSwAlarmSched pSched, ptCwswSwAlarmBatch pBatch)
+{
+	if(!pSched)		{ return; }
+
+	if(pSched->pBatch)	{ (void)Cwsw_SwAlarm__CommitBatch(pSched->pBatch); }
+	pSched->pBatch = pBatch;
+}
+
+
+/**	Remove an alarm from the scheduler, and disable it.
+ *	Safe to call for an alarm that is not registered.
+ */
+void
+Cwsw_SwAlarmSched__Cancel(ptCwswSwAlarmSched pSched, ptCwswSwAlarm pAlarm)
+{
+	if(!pSched || !pAlarm)	{ return; }
+
+	if(pAlarm->ppPrev)
+	{
+		sched_unlink(pSched, pAlarm);
+		--pSched->nalarms;
+		CWSW_TRACE(kCwswTrace_AlarmCancelled, pAlarm->evid, 0);
+	}
+	pAlarm->tmrstate = kTmrState_Disabled;
+}
+
+
+/**	Pause an alarm: take it off the wheel, and freeze the time it has left.
+ *	Time left is measured from the scheduler's last serviced tic, and is held in the alarm's `tm`
+ *	while it is paused. A paused alarm costs the scheduler nothing. Pausing an alarm that isn't
+ *	enabled has no effect.
+ */
+void
+Cwsw_SwAlarmSched__Pause(ptCwswSwAlarmSched pSched, ptCwswSwAlarm pAlarm)
+{
+	if(!pSched || !pAlarm || (pAlarm->tmrstate != kTmrState_Enabled))	{ return; }
+
+	if(pAlarm->ppPrev)
+	{
+		sched_unlink(pSched, pAlarm);
+		--pSched->nalarms;
+	}
+	pAlarm->tm = Cwsw_ElapsedTimeMs(pSched->curtic, pAlarm->tm);
+	pAlarm->tmrstate = kTmrState_Paused;
+}
+
+
+/**	Resume a paused alarm, with the time it had left when it was paused.
+ *	Resuming an alarm that isn't paused has no effect.
+ */
+void
+Cwsw_SwAlarmSched__Resume(ptCwswSwAlarmSched pSched, ptCwswSwAlarm pAlarm)
+{
+	if(!pSched || !pAlarm || (pAlarm->tmrstate != kTmrState_Paused))	{ return; }
+
+	pAlarm->tm = Cwsw_TicsAfter(pSched->curtic, pAlarm->tm);
+	pAlarm->tmrstate = kTmrState_Enabled;
+	(void)Cwsw_SwAlarmSched__Register(pSched, pAlarm);
+}
+
+
+/**	Initialize an empty alarm group. */
+void
+Cwsw_SwAlarmSched__GroupInit(ptCwswSwAlarmGroup pGroup)
+{
+	if(!pGroup)		{ return; }
+
+	pGroup->pMembers = NULL;
+}
+
+
+/**	Add an alarm to a group. The alarm's state is unchanged; it is paused and resumed with the rest
+ *	of the group from the next Cwsw_SwAlarmSched__PauseGroup() or __ResumeGroup() on.
+ *	@returns Error code, where 0 is no error; kErr_SwTmr_BadParm if the alarm already belongs to a
+ *	group (this one included).
+ */
+tErrorCodes_SwTmr
+Cwsw_SwAlarmSched__GroupAdd(ptCwswSwAlarmGroup pGroup, ptCwswSwAlarm pAlarm)
+{
+	if(!pGroup || !pAlarm || pAlarm->pGroup)	{ return kErr_SwTmr_BadParm; }
+
+	pAlarm->pGroupNext = pGroup->pMembers;
+	pAlarm->pGroup = pGroup;
+	pGroup->pMembers = pAlarm;
+	return kErr_SwTmr_NoError;
+}
+
+
+/**	Remove an alarm from a group; nothing if it isn't a member. Cost is linear in the size of the
+ *	group.
+ */
+void
+Cwsw_SwAlarmSched__GroupRemove(ptCwswSwAlarmGroup pGroup, ptCwswSwAlarm pAlarm)
+{
+	ptCwswSwAlarm *ppLink;
+
+	if(!pGroup || !pAlarm || (pAlarm->pGroup != pGroup))	{ return; }
+
+	for(ppLink = &pGroup->pMembers; *ppLink; ppLink = &(*ppLink)->pGroupNext)
+	{
+		if(*ppLink == pAlarm)
+		{
+			*ppLink = pAlarm->pGroupNext;
+			pAlarm->pGroupNext = NULL;
+			pAlarm->pGroup = NULL;
+			return;
+		}
+	}
+}
+
+
+/**	Pause every enabled alarm in a group, in one call.
+ *	@returns Number of alarms paused.
+ */
+uint32_t
+Cwsw_SwAlarmSched__PauseGroup(ptCwswSwAlarmSched pSched, ptCwswSwAlarmGroup pGroup)
+{
+	uint32_t npaused = 0;
+	ptCwswSwAlarm pAlarm;
+
+	if(!pSched || !pGroup)	{ return 0; }
+
+	for(pAlarm = pGroup->pMembers; pAlarm; pAlarm = pAlarm->pGroupNext)
+	{
+		if(pAlarm->tmrstate != kTmrState_Enabled)	{ continue; }
+		Cwsw_SwAlarmSched__Pause(pSched, pAlarm);
+		++npaused;
+	}
+	return npaused;
+}
+
+
+/**	Resume every paused alarm in a group, each with the time it had left.
+ *	Alarms paused individually before the group was paused are resumed as well.
+ *	@returns Number of alarms resumed.
+ */
+uint32_t
+Cwsw_SwAlarmSched__ResumeGroup(ptCwswSwAlarmSched pSched, ptCwswSwAlarmGroup pGroup)
+{
+	uint32_t nresumed = 0;
+	ptCwswSwAlarm pAlarm;
+
+	if(!pSched || !pGroup)	{ return 0; }
+
+	for(pAlarm = pGroup->pMembers; pAlarm; pAlarm = pAlarm->pGroupNext)
+	{
+		if(pAlarm->tmrstate != kTmrState_Paused)	{ continue; }
+		Cwsw_SwAlarmSched__Resume(pSched, pAlarm);
+		++nresumed;
+	}
+	return nresumed;
+}
+
+
+/**	Advance the scheduler to the specified tic, maturing every alarm due on the way, but leave any
+ *	events collected into the scheduler's batch for the caller to deliver.
+ *	Tics are serviced in order, so alarms mature in deadline order even when the caller has fallen
+ *	behind; stretches of tics in which nothing can mature are skipped in one step, so the cost of a
+ *	long advance depends on the alarms it matures, not on its length.
+ *
+ *	Most callers want Cwsw_SwAlarmSched__Advance(); this is for layers that deliver the batch
+ *	themselves (e.g., the sharded scheduler).
+ *
+ *	@param [in,out] pSched	Scheduler.
+ *	@param [in]		now		Raw clock tic to advance to.
+ *	@returns Number of alarms that matured.
+ */
+uint32_t
+Cwsw_SwAlarmSched__Collect(ptCwswSwAlarmSched pSched, tCwswClockTics now)
+{
+	uint32_t fired;
+	uint32_t tic;
+	uint32_t dist;
+	int level;
+
+	if(!pSched)		{ return 0; }
+
+	// anything registered with a deadline that had already arrived.
+	fired = sched_expire(pSched, sched_detach(pSched, &pSched->pDue), now);
+
+	while(Cwsw_ElapsedTimeMs(pSched->curtic, now) > 0)
+	{
+		// with nothing in level 0, nothing can mature before the next occupied outer slot is
+		//	cascaded; skip straight to the tic before that cascade.
+		if(!pSched->occupied[0] && !pSched->pDue)
+		{
+			dist = sched_next_cascade(pSched);
+			if(!dist || (Cwsw_ElapsedTimeMs(Cwsw_TicsAfter(pSched->curtic, dist - 1), now) <= 0))
+			{
+				pSched->curtic = now;
+				break;
+			}
+			pSched->curtic = Cwsw_TicsAfter(pSched->curtic, dist - 1);
+		}
+
+		pSched->curtic = Cwsw_TicsAfter(pSched->curtic, 1);
+		tic = (uint32_t)pSched->curtic;
+
+		// at each rollover of a level, bring the next slot of the level above it closer in.
+		for(level = 1; level < kSwAlarmSched_Levels; ++level)
+		{
+			if(tic & ((1UL << (level * kSwAlarmSched_SlotBits)) - 1))	{ break; }
+			sched_cascade(pSched, level, SLOT_OF(tic, level));
+		}
+
+		fired += sched_expire(pSched, sched_detach(pSched, &pSched->wheel[0][SLOT_OF(tic, 0)]), now);
+		fired += sched_expire(pSched, sched_detach(pSched, &pSched->pDue), now);
+	}
+
+	return fired;
+}
+
+
+/**	Advance the scheduler to the specified tic, maturing every alarm due on the way.
+ *	Events held in overflow buffers are retried first. If a batch is attached, the events collected
+ *	along the way are delivered before returning.
+ *
+ *	@param [in,out] pSched	Scheduler.
+ *	@param [in]		now		Raw clock tic to advance to.
+ *	@returns Number of alarms that matured.
+ */
+uint32_t
+Cwsw_SwAlarmSched__Advance(ptCwswSwAlarmSched pSched, tCwswClockTics now)
+{
+	uint32_t fired;
+
+	Cwsw_SwAlarmOvf__RetryAll();
+	fired = Cwsw_SwAlarmSched__Collect(pSched, now);
+
+	if(pSched && pSched->pBatch)	{ (void)Cwsw_SwAlarm__CommitBatch(pSched->pBatch); }
+	return fired;
+}
+
+
+/**	Task function for the alarm scheduler.
+ *	Call once per heartbeat (e.g., in reaction to the heartbeat event posted by
+ *	Cwsw_ClockSvc__Task()), or simply on every pass through the main loop.
+ *
+ *	@returns Number of alarms that matured.
+ */
+uint32_t
+Cwsw_SwAlarmSched__Task(ptCwswSwAlarmSched pSched)
+{
+	return Cwsw_SwAlarmSched__Advance(pSched, Cwsw_ClockSvc__TimerTic());
+}
+
+
+/**	Find the earliest deadline among registered alarms.
+ *	Within a level, slots are visited in the order they will next be serviced, so the first occupied
+ *	slot holds that level's earliest deadlines; the result is the earliest across all levels. Cost
+ *	is bounded by the size of the wheel plus the population of the few slots inspected.
+ *
+ *	Intended to feed Cwsw_ClockSvc__SetWakeup() in tickless builds.
+ *
+ *	@param [in]		pSched		Scheduler.
+ *	@param [out]	pDeadline	Earliest deadline, as a raw clock tic.
+ *	@returns true if any alarm is registered; false otherwise, and *pDeadline is untouched.
+ */
+bool
+Cwsw_SwAlarmSched__NextDeadline(ptCwswSwAlarmSched pSched, pCwswClockTics pDeadline)
+{
+	bool found = false;
+	tCwswClockTics earliest = 0;
+	tCwswClockTics due;
+	ptCwswSwAlarm pAlarm;
+	uint64_t occupied;
+	uint32_t first;
+	int level;
+
+	if(!pSched || !pDeadline || !pSched->nalarms)	{ return false; }
+
+	if(pSched->pDue)
+	{
+		*pDeadline = pSched->curtic;
+		return true;
+	}
+
+	for(level = 0; level < kSwAlarmSched_Levels; ++level)
+	{
+		// first occupied slot after the current one, found by rotating the occupancy bitmap.
+		occupied = pSched->occupied[level];
+		if(!occupied)	{ continue; }
+
+		first = (SLOT_OF(pSched->curtic, level) + 1) & kSwAlarmSched_SlotMask;
+		if(first)	{ occupied = (occupied >> first) | (occupied << (kSwAlarmSched_Slots - first)); }
+
+		pAlarm = pSched->wheel[level][(first + sched_ctz64(occupied)) & kSwAlarmSched_SlotMask];
+		for(; pAlarm; pAlarm = pAlarm->pNext)
+		{
+			due = sched_due_tic(pAlarm);
+			if(!found || (Cwsw_ElapsedTimeMs(earliest, due) < 0))
+			{
+				earliest = due;
+				found = true;
+			}
+		}
+	}
+
+	if(found)	{ *pDeadline = earliest; }
+	return found;
+}
+
+
+/**	Block the calling thread until the earliest registered alarm is due.
+ *	With no alarm registered, waits for at most kCwswClock_MaxIdleTics. An alarm armed meanwhile by
+ *	another thread doesn't shorten the wait, so a scheduler fed from other threads should instead
+ *	be serviced on each heartbeat (Cwsw_ClockSvc__WaitHeartbeat()).
+ *
+ *	Follow with Cwsw_SwAlarmSched__Task(). See Cwsw_ClockSvc__WaitUntil() for how the wait is done.
+ *
+ *	@param [in]		pSched		Scheduler.
+ *	@returns Current raw clock tic.
+ */
+tCwswClockTics
+Cwsw_SwAlarmSched__Wait(ptCwswSwAlarmSched pSched)
+{
+	tCwswClockTics due;
+
+	if(!Cwsw_SwAlarmSched__NextDeadline(pSched, &due))
+	{
+		due = Cwsw_TicsAfter(Cwsw_ClockSvc__TimerTic(), kCwswClock_MaxIdleTics);
+	}
+	return Cwsw_ClockSvc__WaitUntil(due);
+}
@@ -0,0 +1,329 @@
+/** @file
+ *	@brief	CWSW Sharded SW Alarm Scheduler, for multi-core hosts.
+ *
+ *	Description:
+ *	Ownership rules. An alarm belongs to exactly one shard. Only the shard's owner (the worker
+ *	thread that calls Cwsw_SwAlarmShard__Task() for it) touches the alarm's record and the shard's
+ *	wheel; everyone else goes through the inbox. Rearming a periodic alarm is done by the owner, as
+ *	part of detecting its maturation, so the only work that other workers take on is the delivery
+ *	of already-built events, which touches no alarm state at all.
+ *
+ *	The inbox is a bounded multi-producer / single-consumer queue in which each slot carries a
+ *	sequence number (after D. Vyukov); producers never wait on one another or on the owner.
+ *
+ *	Each pass publishes a ready list as a (round, count, next) triple in one atomic word. Workers
+ *	claim entries by advancing `next` with compare-and-swap, so each event is delivered exactly once
+ *	whichever worker claims it; the round number keeps a worker holding a stale word from claiming
+ *	from a newer list. Successive rounds alternate between two lists, so that workers still posting
+ *	entries claimed from the last round don't hold up the next. The owner never waits for them:
+ *	should the list it would fill still be in use from the round before last, it posts that pass's
+ *	events itself, as they mature.
+ *
+ *	Event queues targeted by sharded alarms must accept posts from several threads at once; a
+ *	queue's overflow buffer, if any, serializes its own use.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+
+// ----	Project Headers -------------------------
+#include "cwsw_evqueue.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_alarmshard.h"
+#include "cwsw_alarmovf.h"
+
+#if (CWSW_CLOCK_MULTICORE)
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum { kSwAlarmShard_InboxMask = kSwAlarmShard_InboxSize - 1 };
+
+/**	@name Fields of a shard's `work` word. */
+//! @{
+#define WORK_ROUND(work)		((uint32_t)((work) >> 32))
+#define WORK_COUNT(work)		((uint16_t)((work) >> 16))
+#define WORK_NEXT(work)			((uint16_t)(work))
+#define WORK_LIST(work)			(WORK_ROUND(work) % kSwAlarmShard_Rounds)
+//! @}
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Global Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/**	Queue a request in a shard's inbox. Callable from any thread. */
+static tErrorCodes_SwTmr
+shard_post(ptCwswSwAlarmShard pShard, ptCwswSwAlarm pAlarm, tCwswClockTics deadline, uint8_t op)
+{
+	tSwAlarmShardReq *pReq;
+	uint32_t pos = atomic_load_explicit(&pShard->inboxhead, memory_order_relaxed);
+	int32_t diff;
+
+	for(;;)
+	{
+		pReq = &pShard->inbox[pos & kSwAlarmShard_InboxMask];
+		diff = (int32_t)(atomic_load_explicit(&pReq->seq, memory_order_acquire) - pos);
+		if(diff == 0)
+		{
+			if(atomic_compare_exchange_weak_explicit(&pShard->inboxhead, &pos, pos + 1,
+				memory_order_relaxed, memory_order_relaxed))
+			{
+				break;
+			}
+		}
+		else if(diff < 0)
+		{
+			return kErr_SwTmr_Full;		// the owner has not yet caught up with its inbox
+		}
+		else
+		{
+			pos = atomic_load_explicit(&pShard->inboxhead, memory_order_relaxed);
+		}
+	}
+
+	pReq->pAlarm = pAlarm;
+	pReq->deadline = deadline;
+	pReq->op = op;
+	atomic_store_explicit(&pReq->seq, pos + 1, memory_order_release);
+	return kErr_SwTmr_NoError;
+}
+
+/**	Apply every request waiting in the owner's inbox. Owner only. */
+static void
+shard_drain_inbox(ptCwswSwAlarmShard pShard)
+{
+	tSwAlarmShardReq *pReq;
+
+	for(;;)
+	{
+		pReq = &pShard->inbox[pShard->inboxtail & kSwAlarmShard_InboxMask];
+		if(atomic_load_explicit(&pReq->seq, memory_order_acquire) != pShard->inboxtail + 1)	{ break; }
+
+		if(pReq->op == kSwAlarmShardOp_Arm)
+		{
+			pReq->pAlarm->tm = pReq->deadline;
+			pReq->pAlarm->tmrstate = kTmrState_Enabled;
+			(void)Cwsw_SwAlarmSched__Register(&pShard->sched, pReq->pAlarm);
+		}
+		else
+		{
+			Cwsw_SwAlarmSched__Cancel(&pShard->sched, pReq->pAlarm);
+		}
+
+		atomic_store_explicit(&pReq->seq, pShard->inboxtail + kSwAlarmShard_InboxSize, memory_order_release);
+		++pShard->inboxtail;
+	}
+}
+
+/**	Claim and deliver entries from a shard's ready list until none remain. Callable by any worker.
+ *	@returns Number of events delivered by this call.
+ */
+static uint32_t
+shard_deliver(ptCwswSwAlarmShard pShard)
+{
+	uint32_t delivered = 0;
+	uint32_t list;
+	uint16_t idx;
+	uint64_t work = atomic_load_explicit(&pShard->work, memory_order_acquire);
+
+	for(;;)
+	{
+		idx = WORK_NEXT(work);
+		if(idx >= WORK_COUNT(work))	{ break; }
+
+		if(!atomic_compare_exchange_weak_explicit(&pShard->work, &work, work + 1,
+			memory_order_acquire, memory_order_acquire))
+		{
+			continue;
+		}
+
+		list = WORK_LIST(work);
+		(void)Cwsw_SwAlarm__Deliver(pShard->ready[list][idx].pEvQX, pShard->ready[list][idx].ev);
+		(void)atomic_fetch_add_explicit(&pShard->ndone[list], 1, memory_order_release);
+		++delivered;
+		++work;
+	}
+	return delivered;
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+/**	Initialize a set of shards over caller-supplied storage.
+ *	Call before any worker thread starts.
+ *
+ *	@param [out]	pSet		Shard set to initialize.
+ *	@param [in]		pShards		Storage for the shards; one per worker thread.
+ *	@param [in]		nshards		Number of shards.
+ *	@returns Error code, where 0 is no error.
+ */
+tErrorCodes_SwTmr
+Cwsw_SwAlarmShard__Init(ptCwswSwAlarmShardSet pSet, ptCwswSwAlarmShard pShards, uint16_t nshards)
+{
+	ptCwswSwAlarmShard pShard;
+	uint32_t idx;
+
+	if(!pSet || !pShards || !nshards)	{ return kErr_SwTmr_BadParm; }
+
+	for(pShard = pShards; pShard < pShards + nshards; ++pShard)
+	{
+		(void)Cwsw_SwAlarmSched__Init(&pShard->sched);
+		(void)Cwsw_SwAlarm__InitBatch(&pShard->staging, pShard->ready[0], kSwAlarmShard_ReadySize);
+		Cwsw_SwAlarmSched__SetBatch(&pShard->sched, &pShard->staging);
+		pShard->inboxtail = 0;
+
+		atomic_init(&pShard->work, 0);
+		for(idx = 0; idx < kSwAlarmShard_Rounds; ++idx)
+		{
+			pShard->nready[idx] = 0;
+			atomic_init(&pShard->ndone[idx], 0);
+		}
+		atomic_init(&pShard->inboxhead, 0);
+		for(idx = 0; idx < kSwAlarmShard_InboxSize; ++idx)
+		{
+			atomic_init(&pShard->inbox[idx].seq, idx);
+		}
+	}
+
+	pSet->pShards = pShards;
+	pSet->nshards = nshards;
+	return kErr_SwTmr_NoError;
+}
+
+
+/**	Arm one of a shard's alarms to mature after the given duration. Callable from any thread.
+ *	The request takes effect on the owner's next pass. The alarm's other attributes (reload time,
+ *	event binding, rearm policy) must be set up before the alarm is first handed to the shard.
+ *
+ *	@returns Error code, where 0 is no error; kErr_SwTmr_Full if the shard's inbox is full.
+ */
+tErrorCodes_SwTmr
+Cwsw_SwAlarmShard__Arm(ptCwswSwAlarmShard pShard, ptCwswSwAlarm pAlarm, tCwswClockTics duration)
+{
+	tCwswClockTics deadline;
+
+	if(!pShard || !pAlarm)	{ return kErr_SwTmr_BadParm; }
+	if(Cwsw_ClockSvc__SetTimer(&deadline, duration) != kErr_ClkSvc_NoError)	{ return kErr_SwTmr_BadParm; }
+
+	return shard_post(pShard, pAlarm, deadline, kSwAlarmShardOp_Arm);
+}
+
+
+/**	Cancel one of a shard's alarms. Callable from any thread; takes effect on the owner's next pass.
+ *	@returns Error code, where 0 is no error; kErr_SwTmr_Full if the shard's inbox is full.
+ */
+tErrorCodes_SwTmr
+Cwsw_SwAlarmShard__Cancel(ptCwswSwAlarmShard pShard, ptCwswSwAlarm pAlarm)
+{
+	if(!pShard || !pAlarm)	{ return kErr_SwTmr_BadParm; }
+
+	return shard_post(pShard, pAlarm, 0, kSwAlarmShardOp_Cancel);
+}
+
+
+/**	Task function for one worker: service the worker's own shard.
+ *	Applies pending requests, advances the shard's wheel to the current tic, publishes the events
+ *	of matured alarms on a ready list, and delivers as many as other workers haven't already
+ *	taken. Never waits on other workers.
+ *
+ *	@param [in,out]	pSet	Shard set.
+ *	@param [in]		self	Index of the calling worker's shard.
+ *	@returns Number of alarms that matured.
+ */
+uint32_t
+Cwsw_SwAlarmShard__Task(ptCwswSwAlarmShardSet pSet, uint16_t self)
+{
+	ptCwswSwAlarmShard pShard;
+	uint32_t fired;
+	uint32_t round;
+	uint32_t list;
+
+	if(!pSet || (self >= pSet->nshards))	{ return 0; }
+	pShard = &pSet->pShards[self];
+
+	shard_drain_inbox(pShard);
+	Cwsw_SwAlarmOvf__RetryAll();
+
+	// claim what is left of the last round; workers may still be posting entries they claimed.
+	(void)shard_deliver(pShard);
+	round = WORK_ROUND(atomic_load_explicit(&pShard->work, memory_order_relaxed)) + 1;
+	list = round % kSwAlarmShard_Rounds;
+
+	// the staging batch is the next ready list, if the round before last is done with it; should
+	//	it fill, the overflow is posted inline. otherwise, every event is posted inline.
+	pShard->staging.pEntries = pShard->ready[list];
+	pShard->staging.count = 0;
+	if(atomic_load_explicit(&pShard->ndone[list], memory_order_acquire) == pShard->nready[list])
+	{
+		pShard->staging.capacity = kSwAlarmShard_ReadySize;
+	}
+	else
+	{
+		pShard->staging.capacity = 0;
+	}
+
+	fired = Cwsw_SwAlarmSched__Collect(&pShard->sched, Cwsw_ClockSvc__TimerTic());
+
+	if(pShard->staging.count)
+	{
+		pShard->nready[list] = pShard->staging.count;
+		atomic_store_explicit(&pShard->ndone[list], 0, memory_order_relaxed);
+		atomic_store_explicit(&pShard->work,
+			((uint64_t)round << 32) | ((uint64_t)pShard->staging.count << 16), memory_order_release);
+		pShard->staging.count = 0;
+	}
+
+	(void)shard_deliver(pShard);
+	return fired;
+}
+
+
+/**	Help other workers: deliver events from the first other shard found with work on its ready list.
+ *	Intended for a worker whose own shard is idle.
+ *
+ *	@param [in,out]	pSet	Shard set.
+ *	@param [in]		self	Index of the calling worker's shard.
+ *	@returns Number of events delivered.
+ */
+uint32_t
+Cwsw_SwAlarmShard__Steal(ptCwswSwAlarmShardSet pSet, uint16_t self)
+{
+	uint32_t delivered = 0;
+	uint16_t idx;
+
+	if(!pSet)	{ return 0; }
+
+	for(idx = 1; (idx < pSet->nshards) && !delivered; ++idx)
+	{
+		delivered = shard_deliver(&pSet->pShards[(self + idx) % pSet->nshards]);
+	}
+	return delivered;
+}
+
+#endif /* CWSW_CLOCK_MULTICORE */
@@ -0,0 +1,158 @@
+/** @file
+ *	@brief	CWSW SW Alarm Simulator: deterministic virtual-time execution of SW alarms.
+ *
+ *	Description:
+ *	Each step asks the scheduler for its earliest deadline, sets virtual time to it, and advances
+ *	the scheduler to exactly that tic; alarms therefore mature, rearm and post with virtual time
+ *	equal to their own deadline, just as they would under a clock serviced on every tic. The
+ *	scheduler skips empty stretches of its wheel, so the jump itself is cheap.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "cwsw_alarmsim.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Global Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+/**	Initialize a simulator, with no alarms, at the given virtual time.
+ *
+ *	@param [out]	pSim	Simulator to initialize.
+ *	@param [in]		start	Initial virtual time. Any value is allowed, including values close to
+ *							rollover of the tic type.
+ *	@returns Error code, where 0 is no error.
+ */
+tErrorCodes_SwTmr
+Cwsw_SwAlarmSim__Init(ptCwswSwAlarmSim pSim, tCwswClockTics start)
+{
+	if(!pSim)		{ return kErr_SwTmr_BadParm; }
+
+	(void)Cwsw_SwAlarmSched__Init(&pSim->sched);
+	Cwsw_SwAlarmSched__SetOrdered(&pSim->sched, true);
+	pSim->sched.curtic = start;
+	pSim->now = start;
+	return kErr_SwTmr_NoError;
+}
+
+
+/**	Arm an alarm to mature the given number of tics after the current virtual time, and enable it.
+ *	May be called from within the reaction to another alarm of the same simulator.
+ *
+ *	@returns Error code, where 0 is no error.
+ */
+tErrorCodes_SwTmr
+Cwsw_SwAlarmSim__Arm(ptCwswSwAlarmSim pSim, ptCwswSwAlarm pAlarm, tCwswClockTics duration)
+{
+	if(!pSim || !pAlarm || (duration <= 0))	{ return kErr_SwTmr_BadParm; }
+
+	pAlarm->tm = Cwsw_TicsAfter(pSim->now, duration);
+	pAlarm->tmrstate = kTmrState_Enabled;
+	return Cwsw_SwAlarmSched__Register(&pSim->sched, pAlarm);
+}
+
+
+/**	Cancel an alarm of the simulator. */
+void
+Cwsw_SwAlarmSim__Cancel(ptCwswSwAlarmSim pSim, ptCwswSwAlarm pAlarm)
+{
+	if(!pSim)		{ return; }
+	Cwsw_SwAlarmSched__Cancel(&pSim->sched, pAlarm);
+}
+
+
+/**	Run the simulator to its next deadline, but no further than `until`.
+ *	Every alarm due at that deadline matures. If no deadline falls within reach, virtual time is
+ *	simply set to `until`.
+ *
+ *	@param [in,out]	pSim	Simulator.
+ *	@param [in]		until	Limit of virtual time for this step.
+ *	@returns Number of alarms that matured.
+ */
+uint32_t
+Cwsw_SwAlarmSim__Step(ptCwswSwAlarmSim pSim, tCwswClockTics until)
+{
+	tCwswClockTics deadline;
+
+	if(!pSim)		{ return 0; }
+	if(Cwsw_ElapsedTimeMs(pSim->now, until) < 0)	{ return 0; }	// never run backwards
+
+	if(!Cwsw_SwAlarmSched__NextDeadline(&pSim->sched, &deadline) || (Cwsw_ElapsedTimeMs(deadline, until) < 0))
+	{
+		deadline = until;
+	}
+	else if(Cwsw_ElapsedTimeMs(pSim->now, deadline) < 0)
+	{
+		deadline = pSim->now;		// already overdue, e.g. armed for a deadline in the past
+	}
+
+	pSim->now = deadline;
+	return Cwsw_SwAlarmSched__Advance(&pSim->sched, deadline);
+}
+
+
+/**	Run the simulator until the given virtual time, maturing every alarm due up to and including it,
+ *	in deadline order. Alarms armed or rearmed along the way are honored if they fall within the run.
+ *
+ *	@returns Number of alarms that matured.
+ */
+uint32_t
+Cwsw_SwAlarmSim__RunUntil(ptCwswSwAlarmSim pSim, tCwswClockTics until)
+{
+	uint32_t fired = 0;
+
+	if(!pSim)		{ return 0; }
+	if(Cwsw_ElapsedTimeMs(pSim->now, until) < 0)	{ return 0; }
+
+	// keep going at `until` itself while reactions there leave work already due.
+	do {
+		fired += Cwsw_SwAlarmSim__Step(pSim, until);
+	} while((pSim->now != until) || pSim->sched.pDue);
+
+	return fired;
+}
+
+
+/**	Run the simulator for the given number of tics of virtual time.
+ *	@returns Number of alarms that matured.
+ */
+uint32_t
+Cwsw_SwAlarmSim__RunFor(ptCwswSwAlarmSim pSim, tCwswClockTics duration)
+{
+	if(!pSim || (duration < 0))	{ return 0; }
+	return Cwsw_SwAlarmSim__RunUntil(pSim, Cwsw_TicsAfter(pSim->now, duration));
+}
@@ -0,0 +1,350 @@
+/** @file
+ *	@brief	CWSW SW Alarm Snapshots: save and restore alarm state across a process restart.
+ *
+ *	Description:
+ *	File layout: one header, then one fixed-size record per alarm, in set order. The header carries
+ *	a checksum (FNV-1a) over the header and records together, computed with the checksum field
+ *	itself zeroed.
+ *
+ *	Time left is measured against the scheduler's last serviced tic when the set has a scheduler
+ *	(as for Cwsw_SwAlarmSched__Pause()), and against the clock's current tic otherwise.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdio.h>
+#include <string.h>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define SNAP_POSIX	1
+#else
+#define SNAP_POSIX	0
+#endif
+
+// ----	Project Headers -------------------------
+#include "cwsw_evqueue.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_alarmsnap.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum {
+	kSnap_NoQueue	= 0xFFFF,		//!< Queue index of an alarm bound to no queue.
+	kSnap_MaxPath	= 1024			//!< Longest snapshot path, including the temporary suffix.
+};
+
+static const char tmpsuffix[] = ".tmp";
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/**	Snapshot header. */
+typedef struct sSwAlarmSnapHeader {
+	uint32_t		magic;
+	uint16_t		version;
+	uint16_t		recsize;
+	uint32_t		nalarms;
+	uint32_t		checksum;
+	int64_t			ticns;			/**< CWSW_CLOCK_TIC_NS of the build that saved it. */
+	tCwswClockTics	sinceinit;		/**< Clock's tics since initialization, at save. */
+} tSwAlarmSnapHeader;
+
+/**	Saved state of one alarm. */
+typedef struct sSwAlarmSnapRec {
+	tCwswClockTics	remaining;		/**< Tics left; may be negative for an enabled alarm already due. */
+	tCwswClockTics	reloadtm;
+	tCwswClockTics	slack;
+	int16_t			evid;
+	uint16_t		queue;			/**< Index in the set's queue table, or kSnap_NoQueue. */
+	uint8_t			state;
+	uint8_t			rearm;
+	uint8_t			reserved[2];
+} tSwAlarmSnapRec;
+
+
+// ============================================================================
+// ----	Global Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/**	FNV-1a over a span of bytes, continuing from `hash`. */
+static uint32_t
+snap_fnv1a(uint32_t hash, const void *pData, size_t len)
+{
+	const uint8_t *pByte = (const uint8_t *)pData;
+
+	while(len--)
+	{
+		hash ^= *pByte++;
+		hash *= 16777619UL;
+	}
+	return hash;
+}
+
+/**	Checksum of a whole snapshot image, taken as though its checksum field were 0. */
+static uint32_t
+snap_checksum(const tSwAlarmSnapHeader *pHdr, const tSwAlarmSnapRec *pRecs)
+{
+	tSwAlarmSnapHeader hdr = *pHdr;
+	uint32_t hash = 2166136261UL;
+
+	hdr.checksum = 0;
+	hash = snap_fnv1a(hash, &hdr, sizeof(hdr));
+	return snap_fnv1a(hash, pRecs, (size_t)pHdr->nalarms * sizeof(*pRecs));
+}
+
+/**	Tic against which the set's remaining times are measured. */
+static tCwswClockTics
+snap_reftic(const tCwswSwAlarmSnapSet *pSet)
+{
+	return pSet->pSched ? pSet->pSched->curtic : Cwsw_ClockSvc__TimerTic();
+}
+
+/**	Index of a queue in the set's table; kSnap_NoQueue for no queue, or nqueues if not listed. */
+static uint16_t
+snap_queue_index(const tCwswSwAlarmSnapSet *pSet, ptEvQ_QueueCtrlEx pEvQX)
+{
+	uint16_t idx;
+
+	if(!pEvQX)		{ return kSnap_NoQueue; }
+	for(idx = 0; (idx < pSet->nqueues) && (pSet->pQueues[idx] != pEvQX); ++idx)
+	{
+		// keep looking
+	}
+	return idx;
+}
+
+/**	Check that a snapshot image is whole, of this format and tic length, and fits the set. */
+static bool
+snap_valid(const tCwswSwAlarmSnapSet *pSet, const void *pImage, size_t size)
+{
+	const tSwAlarmSnapHeader *pHdr = (const tSwAlarmSnapHeader *)pImage;
+	const tSwAlarmSnapRec *pRecs = (const tSwAlarmSnapRec *)(pHdr + 1);
+	uint32_t idx;
+
+	if(size < sizeof(*pHdr))										{ return false; }
+	if((pHdr->magic != kSwAlarmSnap_Magic) || (pHdr->version != kSwAlarmSnap_Version))	{ return false; }
+	if((pHdr->recsize != sizeof(*pRecs)) || (pHdr->ticns != CWSW_CLOCK_TIC_NS))		{ return false; }
+	if((pHdr->nalarms != pSet->nalarms) || (size != sizeof(*pHdr) + (size_t)pHdr->nalarms * sizeof(*pRecs)))	{ return false; }
+	if(pHdr->checksum != snap_checksum(pHdr, pRecs))				{ return false; }
+
+	for(idx = 0; idx < pHdr->nalarms; ++idx)
+	{
+		if(pRecs[idx].state > kTmrState_Paused)						{ return false; }
+		if(pRecs[idx].rearm > kSwAlarmRearm_PostCount)				{ return false; }
+		if((pRecs[idx].queue != kSnap_NoQueue) && (pRecs[idx].queue >= pSet->nqueues))	{ return false; }
+	}
+	return true;
+}
+
+/**	Apply a validated snapshot image to the set. */
+static void
+snap_apply(const tCwswSwAlarmSnapSet *pSet, const void *pImage)
+{
+	const tSwAlarmSnapHeader *pHdr = (const tSwAlarmSnapHeader *)pImage;
+	const tSwAlarmSnapRec *pRec = (const tSwAlarmSnapRec *)(pHdr + 1);
+	ptCwswSwAlarm pAlarm;
+	tCwswClockTics now = snap_reftic(pSet);
+
+	Cwsw_ClockSvc__Rebase(pHdr->sinceinit);
+
+	for(pAlarm = pSet->pAlarms; pAlarm < pSet->pAlarms + pSet->nalarms; ++pAlarm, ++pRec)
+	{
+		if(pSet->pSched)	{ Cwsw_SwAlarmSched__Cancel(pSet->pSched, pAlarm); }
+
+		pAlarm->reloadtm = pRec->reloadtm;
+		pAlarm->slack = pRec->slack;
+		pAlarm->evid = pRec->evid;
+		pAlarm->pEvQX = (pRec->queue == kSnap_NoQueue) ? NULL : pSet->pQueues[pRec->queue];
+		pAlarm->rearm = (tSwAlarmRearm)pRec->rearm;
+		pAlarm->tmrstate = (tSwTimerState)pRec->state;
+
+		// paused (and disabled) alarms hold their time left; enabled ones get a deadline.
+		if(pAlarm->tmrstate == kTmrState_Enabled)
+		{
+			pAlarm->tm = Cwsw_TicsAfter(now, pRec->remaining);
+			if(pSet->pSched)	{ (void)Cwsw_SwAlarmSched__Register(pSet->pSched, pAlarm); }
+		}
+		else
+		{
+			pAlarm->tm = pRec->remaining;
+		}
+	}
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+/**	Save a snapshot of a set of alarms, and of the clock's tics since initialization.
+ *
+ *	@param [in]	path	Snapshot file; replaced whole.
+ *	@param [in]	pSet	Alarms to save.
+ *	@returns Error code, where 0 is no error; kErr_SwTmr_BadParm if an alarm posts to a queue
+ *			missing from the set's table; kErr_SwTmr_Io if the file can't be written or synced.
+ */
+tErrorCodes_SwTmr
+Cwsw_SwAlarmSnap__Save(const char *path, const tCwswSwAlarmSnapSet *pSet)
+{
+#if (SNAP_POSIX)
+	char tmppath[kSnap_MaxPath];
+	tSwAlarmSnapHeader *pHdr;
+	tSwAlarmSnapRec *pRec;
+	const tCwswSwAlarm *pAlarm;
+	tCwswClockSnapshot clk;
+	tCwswClockTics now;
+	size_t size;
+	void *pImage;
+	bool synced;
+	int fd;
+
+	if(!path || !pSet || (!pSet->pAlarms && pSet->nalarms) || (!pSet->pQueues && pSet->nqueues))	{ return kErr_SwTmr_BadParm; }
+	if(strlen(path) + sizeof(tmpsuffix) > sizeof(tmppath))			{ return kErr_SwTmr_BadParm; }
+	for(pAlarm = pSet->pAlarms; pAlarm < pSet->pAlarms + pSet->nalarms; ++pAlarm)
+	{
+		if(snap_queue_index(pSet, pAlarm->pEvQX) == pSet->nqueues)	{ return kErr_SwTmr_BadParm; }
+	}
+
+	(void)strcpy(tmppath, path);
+	(void)strcat(tmppath, tmpsuffix);
+	size = sizeof(*pHdr) + (size_t)pSet->nalarms * sizeof(*pRec);
+
+	fd = open(tmppath, O_RDWR | O_CREAT | O_TRUNC, 0600);
+	if(fd < 0)		{ return kErr_SwTmr_Io; }
+	if(ftruncate(fd, (off_t)size) != 0)
+	{
+		(void)close(fd);
+		(void)unlink(tmppath);
+		return kErr_SwTmr_Io;
+	}
+	pImage = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if(pImage == MAP_FAILED)
+	{
+		(void)close(fd);
+		(void)unlink(tmppath);
+		return kErr_SwTmr_Io;
+	}
+
+	pHdr = (tSwAlarmSnapHeader *)pImage;
+	pRec = (tSwAlarmSnapRec *)(pHdr + 1);
+	memset(pImage, 0, size);
+
+	Cwsw_ClockSvc__GetSnapshot(&clk);
+	pHdr->magic = kSwAlarmSnap_Magic;
+	pHdr->version = kSwAlarmSnap_Version;
+	pHdr->recsize = (uint16_t)sizeof(*pRec);
+	pHdr->nalarms = pSet->nalarms;
+	pHdr->ticns = CWSW_CLOCK_TIC_NS;
+	pHdr->sinceinit = clk.sinceinit;
+
+	now = snap_reftic(pSet);
+	for(pAlarm = pSet->pAlarms; pAlarm < pSet->pAlarms + pSet->nalarms; ++pAlarm, ++pRec)
+	{
+		pRec->remaining = (pAlarm->tmrstate == kTmrState_Enabled) ? Cwsw_ElapsedTimeMs(now, pAlarm->tm) : pAlarm->tm;
+		pRec->reloadtm = pAlarm->reloadtm;
+		pRec->slack = pAlarm->slack;
+		pRec->evid = pAlarm->evid;
+		pRec->queue = snap_queue_index(pSet, pAlarm->pEvQX);
+		pRec->state = (uint8_t)pAlarm->tmrstate;
+		pRec->rearm = (uint8_t)pAlarm->rearm;
+	}
+	pHdr->checksum = snap_checksum(pHdr, (const tSwAlarmSnapRec *)(pHdr + 1));
+
+	// the new snapshot must be on storage before it replaces the old one, or a crash could leave neither.
+	synced = (msync(pImage, size, MS_SYNC) == 0);
+	(void)munmap(pImage, size);
+	synced = synced && (fsync(fd) == 0);
+	(void)close(fd);
+	if(!synced || (rename(tmppath, path) != 0))
+	{
+		(void)unlink(tmppath);
+		return kErr_SwTmr_Io;
+	}
+	return kErr_SwTmr_NoError;
+#else
+	(void)path;
+	(void)pSet;
+	return kErr_SwTmr_Io;
+#endif
+}
+
+
+/**	Restore a set of alarms, and the clock's count of tics since initialization, from a snapshot.
+ *	Call after Cwsw_ClockSvc__Init() and, for a scheduled set, Cwsw_SwAlarmSched__Init(), with the
+ *	alarms set up as before the restart (at least their callbacks, which aren't saved). Each alarm's
+ *	timing, state and event binding are replaced; enabled alarms are due their saved time left after
+ *	the current tic, and are registered with the set's scheduler. If the snapshot is unusable, no
+ *	alarm is touched.
+ *
+ *	@param [in]	path	Snapshot file.
+ *	@param [in]	pSet	Alarms to restore; must describe the set that was saved.
+ *	@returns Error code, where 0 is no error; kErr_SwTmr_Io if the file can't be read;
+ *			kErr_SwTmr_BadSnapshot if it fails validation.
+ */
+tErrorCodes_SwTmr
+Cwsw_SwAlarmSnap__Restore(const char *path, const tCwswSwAlarmSnapSet *pSet)
+{
+#if (SNAP_POSIX)
+	tErrorCodes_SwTmr rc = kErr_SwTmr_BadSnapshot;
+	struct stat st;
+	void *pImage;
+	int fd;
+
+	if(!path || !pSet || (!pSet->pAlarms && pSet->nalarms) || (!pSet->pQueues && pSet->nqueues))	{ return kErr_SwTmr_BadParm; }
+
+	fd = open(path, O_RDONLY);
+	if(fd < 0)		{ return kErr_SwTmr_Io; }
+	if(fstat(fd, &st) != 0)
+	{
+		(void)close(fd);
+		return kErr_SwTmr_Io;
+	}
+	if(st.st_size < (off_t)sizeof(tSwAlarmSnapHeader))
+	{
+		(void)close(fd);
+		return kErr_SwTmr_BadSnapshot;
+	}
+	pImage = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	(void)close(fd);
+	if(pImage == MAP_FAILED)	{ return kErr_SwTmr_Io; }
+
+	if(snap_valid(pSet, pImage, (size_t)st.st_size))
+	{
+		snap_apply(pSet, pImage);
+		rc = kErr_SwTmr_NoError;
+	}
+
+	(void)munmap(pImage, (size_t)st.st_size);
+	return rc;
+#else
+	(void)path;
+	(void)pSet;
+	return kErr_SwTmr_Io;
+#endif
+}
@@ -0,0 +1,184 @@
+/** @file
+ *	@brief	CWSW Static Alarm Schedule: a fixed set of periodic alarms, laid out at compile time.
+ *
+ *	Description:
+ *	The schedule is a cyclic executive. Frame `k` of the hyperperiod begins `k` minor frames after
+ *	the start of each hyperperiod, and its slot says which alarms are due; the dispatcher reads the
+ *	slot and posts those alarms' events, and that is all it does. Missed frames are caught up in
+ *	order, except that a lapse of a whole hyperperiod or more is skipped, with the schedule kept in
+ *	phase.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+
+// ----	Project Headers -------------------------
+#include "cwsw_evqueue.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_alarmstatic.h"
+#include "cwsw_alarmovf.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Global Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/**	Index of the lowest set bit; `w` must be nonzero. */
+static uint32_t
+static_ctz(uint32_t w)
+{
+#if defined(__GNUC__)
+	return (uint32_t)__builtin_ctz(w);
+#else
+	uint32_t n = 0;
+	while(!(w & 1))	{ w >>= 1; ++n; }
+	return n;
+#endif
+}
+
+/**	Post the events of the alarms due in one frame.
+ *	@returns Number of events posted.
+ */
+static uint32_t
+static_dispatch(const tCwswSwAlarmStaticTable *pTbl, uint16_t frame, tCwswClockTics tic)
+{
+	uint32_t due = pTbl->pSlots[frame];
+	uint32_t posted = 0;
+	tEvQ_Event ev;
+
+	ev.evData = (uint32_t)tic;
+	while(due)
+	{
+		ev.evId = (tEvQ_EventID)pTbl->pEntries[static_ctz(due)].evid;
+		(void)Cwsw_SwAlarm__Deliver(pTbl->pEvQX, ev);
+		due &= due - 1;
+		++posted;
+	}
+	return posted;
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+/**	Start (or restart) a static schedule.
+ *	Optional: a schedule not started explicitly starts on its first task call.
+ *
+ *	@param [in,out]	pRun	Schedule state.
+ *	@param [in]		epoch	Raw clock tic at which the schedule's first frame begins; each alarm
+ *							first matures its phase after this.
+ */
+void
+Cwsw_SwAlarmStatic__Start(ptCwswSwAlarmStatic pRun, tCwswClockTics epoch)
+{
+	if(!pRun)	{ return; }
+
+	pRun->nextframe = epoch;
+	pRun->frame = 0;
+	pRun->started = true;
+}
+
+
+/**	Run a static schedule up to the specified tic, posting the events of every frame begun by then.
+ *	@param [in,out]	pRun	Schedule state.
+ *	@param [in]		now		Raw clock tic.
+ *	@returns Number of events posted.
+ */
+uint32_t
+Cwsw_SwAlarmStatic__Advance(ptCwswSwAlarmStatic pRun, tCwswClockTics now)
+{
+	const tCwswSwAlarmStaticTable *pTbl;
+	tCwswClockTics behind;
+	uint32_t posted = 0;
+
+	if(!pRun || !pRun->pTbl)	{ return 0; }
+	pTbl = pRun->pTbl;
+
+	if(!pRun->started)	{ Cwsw_SwAlarmStatic__Start(pRun, now); }
+	Cwsw_SwAlarmOvf__RetryAll();
+
+	// a lapse of whole hyperperiods brings the schedule back to the same frame; skip them.
+	behind = Cwsw_ElapsedTimeMs(pRun->nextframe, now);
+	if(behind >= pTbl->hyperperiod)
+	{
+		pRun->nextframe = Cwsw_TicsAfter(pRun->nextframe, (behind / pTbl->hyperperiod) * pTbl->hyperperiod);
+	}
+
+	while(Cwsw_ElapsedTimeMs(pRun->nextframe, now) >= 0)
+	{
+		posted += static_dispatch(pTbl, pRun->frame, pRun->nextframe);
+		if(++pRun->frame >= pTbl->nframes)	{ pRun->frame = 0; }
+		pRun->nextframe = Cwsw_TicsAfter(pRun->nextframe, pTbl->minor);
+	}
+	return posted;
+}
+
+
+/**	Task function for a static schedule; call once per heartbeat.
+ *	@returns Number of events posted.
+ */
+uint32_t
+Cwsw_SwAlarmStatic__Task(ptCwswSwAlarmStatic pRun)
+{
+	return Cwsw_SwAlarmStatic__Advance(pRun, Cwsw_ClockSvc__TimerTic());
+}
+
+
+/**	Find the tic of the next frame in which any alarm is due.
+ *	Intended, as with Cwsw_SwAlarmSched__NextDeadline(), to feed Cwsw_ClockSvc__SetWakeup() or
+ *	Cwsw_ClockSvc__WaitUntil().
+ *
+ *	@param [in]		pRun		Schedule state.
+ *	@param [out]	pDeadline	Next deadline, as a raw clock tic.
+ *	@returns true if the schedule has started; false otherwise, and *pDeadline is untouched.
+ */
+bool
+Cwsw_SwAlarmStatic__NextDeadline(const tCwswSwAlarmStatic *pRun, pCwswClockTics pDeadline)
+{
+	const tCwswSwAlarmStaticTable *pTbl;
+	tCwswClockTics tic;
+	uint16_t frame;
+	uint16_t n;
+
+	if(!pRun || !pRun->pTbl || !pDeadline || !pRun->started)	{ return false; }
+	pTbl = pRun->pTbl;
+
+	// every alarm is due once per hyperperiod, so one lap of the frames finds a deadline.
+	tic = pRun->nextframe;
+	frame = pRun->frame;
+	for(n = 0; (n < pTbl->nframes) && !pTbl->pSlots[frame]; ++n)
+	{
+		if(++frame >= pTbl->nframes)	{ frame = 0; }
+		tic = Cwsw_TicsAfter(tic, pTbl->minor);
+	}
+
+	*pDeadline = tic;
+	return true;
+}
@@ -0,0 +1,353 @@
+/** @file
+ *	@brief	CWSW SW Alarm Table (structure-of-arrays alarm storage).
+ *
+ *	Description:
+ *	Expiry detection is a compare-and-mask over the dense deadline array, 32 alarms (one bitset
+ *	word) at a time: subtract each deadline from the current tic, and collect the sign bits of the
+ *	differences. This is the same rollover-safe test as Cwsw_ElapsedTimeMs(), and maps directly onto
+ *	SIMD subtract + movemask; SSE2 and AVX2 versions are selected at compile time, with a scalar
+ *	fallback for other targets (or when CWSW_ALARMTABLE_SIMD is zero). Words with no enabled alarms
+ *	are skipped outright.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <string.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_evqueue.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_alarmtable.h"
+#include "cwsw_alarmovf.h"
+
+#if (CWSW_ALARMTABLE_SIMD) && defined(__AVX2__)
+#define TBL_AVX2	1
+#include <immintrin.h>
+#elif (CWSW_ALARMTABLE_SIMD) && defined(__SSE2__)
+#define TBL_SSE2	1
+#include <emmintrin.h>
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Global Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/**	Index of the lowest set bit; `w` must be nonzero. */
+static uint32_t
+tbl_ctz(uint32_t w)
+{
+#if defined(__GNUC__)
+	return (uint32_t)__builtin_ctz(w);
+#else
+	uint32_t n = 0;
+	while(!(w & 1))	{ w >>= 1; ++n; }
+	return n;
+#endif
+}
+
+/**	Expiry mask for up to one word's worth of alarms; bit `i` is set if deadline `i` has arrived. */
+static uint32_t
+tbl_expired_scalar(const tCwswClockTics *pDeadlines, uint32_t n, tCwswClockTics now)
+{
+	uint32_t bits = 0;
+	uint32_t i;
+
+	for(i = 0; i < n; ++i)
+	{
+		if(Cwsw_ElapsedTimeMs(pDeadlines[i], now) >= 0)	{ bits |= (1UL << i); }
+	}
+	return bits;
+}
+
+/**	Expiry mask for one full word (32 alarms).
+ *	The sign bit of (now - deadline) is set for alarms not yet due; movemask gathers those sign
+ *	bits, and the complement is the expiry mask. Tics are 64 bits wide: 4 per AVX2 vector, 2 per
+ *	SSE2 vector.
+ */
+static uint32_t
+tbl_expired_word(const tCwswClockTics *pDeadlines, tCwswClockTics now)
+{
+#if defined(TBL_AVX2)
+	__m256i vnow = _mm256_set1_epi64x((long long)now);
+	uint32_t pending = 0;
+	uint32_t i;
+
+	for(i = 0; i < kSwAlarmTable_BitsPerWord; i += 4)
+	{
+		__m256i diff = _mm256_sub_epi64(vnow, _mm256_loadu_si256((const __m256i *)(pDeadlines + i)));
+		pending |= (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(diff)) << i;
+	}
+	return ~pending;
+
+#elif defined(TBL_SSE2)
+	__m128i vnow = _mm_set1_epi64x((long long)now);
+	uint32_t pending = 0;
+	uint32_t i;
+
+	for(i = 0; i < kSwAlarmTable_BitsPerWord; i += 2)
+	{
+		__m128i diff = _mm_sub_epi64(vnow, _mm_loadu_si128((const __m128i *)(pDeadlines + i)));
+		pending |= (uint32_t)_mm_movemask_pd(_mm_castsi128_pd(diff)) << i;
+	}
+	return ~pending;
+
+#else
+	return tbl_expired_scalar(pDeadlines, kSwAlarmTable_BitsPerWord, now);
+#endif
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+/**	Initialize an alarm table over caller-supplied storage.
+ *	The table takes each alarm's deadline and enabled state from its record, so alarms may be set up
+ *	with Cwsw_SwAlarm__Init() (and Cwsw_SwAlarm__SetState()) beforehand.
+ *
+ *	@param [out]	pTbl		Table to initialize.
+ *	@param [in]		pDeadlines	Storage for `capacity` deadlines.
+ *	@param [in]		pEnabled	Storage for CWSW_ALARMTABLE_WORDS(capacity) words.
+ *	@param [in]		pMatured	Storage for CWSW_ALARMTABLE_WORDS(capacity) words.
+ *	@param [in]		pAlarms		The alarm records.
+ *	@param [in]		capacity	Number of alarms.
+ *	@returns Error code, where 0 is no error.
+ */
+tErrorCodes_SwTmr
+Cwsw_SwAlarmTable__Init(
+	ptCwswSwAlarmTable	pTbl,
+	tCwswClockTics		*pDeadlines,
+	uint32_t			*pEnabled,
+	uint32_t			*pMatured,
+	ptCwswSwAlarm		pAlarms,
+	uint32_t			capacity)
+{
+	uint32_t idx;
+
+	if(!pTbl || !pDeadlines || !pEnabled || !pMatured || !pAlarms || !capacity)	{ return kErr_SwTmr_BadParm; }
+
+	pTbl->pDeadlines = pDeadlines;
+	pTbl->pEnabled = pEnabled;
+	pTbl->pMatured = pMatured;
+	pTbl->pAlarms = pAlarms;
+	pTbl->capacity = capacity;
+	pTbl->pBatch = NULL;
+	pTbl->scantm = 0;
+	pTbl->pMaturing = NULL;
+
+	memset(pEnabled, 0, CWSW_ALARMTABLE_WORDS(capacity) * sizeof(*pEnabled));
+	memset(pMatured, 0, CWSW_ALARMTABLE_WORDS(capacity) * sizeof(*pMatured));
+	for(idx = 0; idx < capacity; ++idx)
+	{
+		pDeadlines[idx] = pAlarms[idx].tm;
+		if(pAlarms[idx].tmrstate == kTmrState_Enabled)
+		{
+			pEnabled[idx / kSwAlarmTable_BitsPerWord] |= (1UL << (idx % kSwAlarmTable_BitsPerWord));
+		}
+	}
+	return kErr_SwTmr_NoError;
+}
+
+
+/**	Arm one alarm of the table to mature after the given duration, and enable it. */
+tErrorCodes_SwTmr
+Cwsw_SwAlarmTable__Arm(ptCwswSwAlarmTable pTbl, uint32_t idx, tCwswClockTics duration)
+{
+	if(!pTbl || (idx >= pTbl->capacity))	{ return kErr_SwTmr_BadParm; }
+	if(Cwsw_ClockSvc__SetTimer(&pTbl->pDeadlines[idx], duration) != kErr_ClkSvc_NoError)	{ return kErr_SwTmr_BadParm; }
+
+	pTbl->pEnabled[idx / kSwAlarmTable_BitsPerWord] |= (1UL << (idx % kSwAlarmTable_BitsPerWord));
+	pTbl->pAlarms[idx].tm = pTbl->pDeadlines[idx];	// for Dispatch(), should the alarm be maturing
+	pTbl->pAlarms[idx].tmrstate = kTmrState_Enabled;
+	return kErr_SwTmr_NoError;
+}
+
+
+/**	Disable one alarm of the table. */
+void
+Cwsw_SwAlarmTable__Disable(ptCwswSwAlarmTable pTbl, uint32_t idx)
+{
+	if(!pTbl || (idx >= pTbl->capacity))	{ return; }
+
+	pTbl->pEnabled[idx / kSwAlarmTable_BitsPerWord] &= ~(1UL << (idx % kSwAlarmTable_BitsPerWord));
+	pTbl->pAlarms[idx].tmrstate = kTmrState_Disabled;
+}
+
+
+/**	Pause one alarm of the table: clear its enable bit, so scans skip it, and freeze the time it has
+ *	left in its record. Pausing an alarm that isn't enabled has no effect.
+ */
+void
+Cwsw_SwAlarmTable__Pause(ptCwswSwAlarmTable pTbl, uint32_t idx)
+{
+	ptCwswSwAlarm pAlarm;
+
+	if(!pTbl || (idx >= pTbl->capacity))	{ return; }
+	pAlarm = &pTbl->pAlarms[idx];
+	if(pAlarm->tmrstate != kTmrState_Enabled)	{ return; }
+
+	// a periodic alarm paused from its own callback has already been rearmed, in its record.
+	if(pAlarm != pTbl->pMaturing)	{ pAlarm->tm = pTbl->pDeadlines[idx]; }
+
+	pTbl->pEnabled[idx / kSwAlarmTable_BitsPerWord] &= ~(1UL << (idx % kSwAlarmTable_BitsPerWord));
+	pAlarm->tm = Cwsw_GetTimeLeft(pAlarm->tm);
+	pAlarm->tmrstate = kTmrState_Paused;
+}
+
+
+/**	Resume one paused alarm of the table, with the time it had left. */
+void
+Cwsw_SwAlarmTable__Resume(ptCwswSwAlarmTable pTbl, uint32_t idx)
+{
+	if(!pTbl || (idx >= pTbl->capacity))						{ return; }
+	if(pTbl->pAlarms[idx].tmrstate != kTmrState_Paused)		{ return; }
+
+	pTbl->pDeadlines[idx] = Cwsw_TicsAfter(Cwsw_ClockSvc__TimerTic(), pTbl->pAlarms[idx].tm);
+	pTbl->pEnabled[idx / kSwAlarmTable_BitsPerWord] |= (1UL << (idx % kSwAlarmTable_BitsPerWord));
+	pTbl->pAlarms[idx].tm = pTbl->pDeadlines[idx];	// for Dispatch(), should the alarm be maturing
+	pTbl->pAlarms[idx].tmrstate = kTmrState_Enabled;
+}
+
+
+/**	Find every enabled alarm whose deadline has arrived.
+ *	The result is left in the table's matured bitset, for Cwsw_SwAlarmTable__Dispatch().
+ *
+ *	@param [in,out]	pTbl	Table.
+ *	@param [in]		now		Raw clock tic to test against.
+ *	@returns Number of matured alarms.
+ */
+uint32_t
+Cwsw_SwAlarmTable__Scan(ptCwswSwAlarmTable pTbl, tCwswClockTics now)
+{
+	uint32_t nwords;
+	uint32_t word;
+	uint32_t base;
+	uint32_t bits;
+	uint32_t nmatured = 0;
+
+	if(!pTbl)		{ return 0; }
+
+	pTbl->scantm = now;
+	nwords = CWSW_ALARMTABLE_WORDS(pTbl->capacity);
+	for(word = 0; word < nwords; ++word)
+	{
+		bits = pTbl->pEnabled[word];
+		if(bits)
+		{
+			base = word * kSwAlarmTable_BitsPerWord;
+			if(pTbl->capacity - base >= kSwAlarmTable_BitsPerWord)
+			{
+				bits &= tbl_expired_word(&pTbl->pDeadlines[base], now);
+			}
+			else
+			{
+				bits &= tbl_expired_scalar(&pTbl->pDeadlines[base], pTbl->capacity - base, now);
+			}
+		}
+		pTbl->pMatured[word] = bits;
+
+		for(; bits; bits &= bits - 1)	{ ++nmatured; }
+	}
+	return nmatured;
+}
+
+
+/**	Mature every alarm flagged by the last scan.
+ *	Only the records of matured alarms are touched. One-shot alarms are disabled before they mature;
+ *	periodic alarms get their new deadline written back to the table after. Either way, an alarm's
+ *	callback may arm, pause or disable it, or any other alarm of the table, and that is what sticks:
+ *	a flagged alarm that is no longer enabled, or no longer due, when its turn comes is skipped.
+ *
+ *	@returns Number of alarms that matured.
+ */
+uint32_t
+Cwsw_SwAlarmTable__Dispatch(ptCwswSwAlarmTable pTbl)
+{
+	uint32_t nwords;
+	uint32_t word;
+	uint32_t bits;
+	uint32_t idx;
+	uint32_t fired = 0;
+	ptCwswSwAlarm pAlarm;
+
+	if(!pTbl)		{ return 0; }
+
+	nwords = CWSW_ALARMTABLE_WORDS(pTbl->capacity);
+	for(word = 0; word < nwords; ++word)
+	{
+		bits = pTbl->pMatured[word];
+		pTbl->pMatured[word] = 0;
+
+		for(; bits; bits &= bits - 1)
+		{
+			idx = (word * kSwAlarmTable_BitsPerWord) + tbl_ctz(bits);
+			pAlarm = &pTbl->pAlarms[idx];
+
+			// an earlier callback of this pass may have disabled, paused or re-armed this alarm.
+			if(!(pTbl->pEnabled[word] & (1UL << (idx % kSwAlarmTable_BitsPerWord)))
+				|| (Cwsw_ElapsedTimeMs(pTbl->pDeadlines[idx], pTbl->scantm) < 0))
+			{
+				continue;
+			}
+
+			pAlarm->tm = pTbl->pDeadlines[idx];
+			++fired;
+
+			if(pAlarm->reloadtm > 0)
+			{
+				// the rearm lands in the record; while the callback runs, the table looks there.
+				pTbl->pMaturing = pAlarm;
+				Cwsw_SwAlarm__Mature(pAlarm, pTbl->pBatch, pTbl->scantm);
+				pTbl->pMaturing = NULL;
+				if(pAlarm->tmrstate == kTmrState_Enabled)	{ pTbl->pDeadlines[idx] = pAlarm->tm; }
+			}
+			else
+			{
+				Cwsw_SwAlarmTable__Disable(pTbl, idx);
+				Cwsw_SwAlarm__Mature(pAlarm, pTbl->pBatch, pTbl->scantm);
+			}
+		}
+	}
+
+	if(pTbl->pBatch)	{ (void)Cwsw_SwAlarm__CommitBatch(pTbl->pBatch); }
+	return fired;
+}
+
+
+/**	Task function for an alarm table: scan against the current tic, then dispatch.
+ *	@returns Number of alarms that matured.
+ */
+uint32_t
+Cwsw_SwAlarmTable__Task(ptCwswSwAlarmTable pTbl)
+{
+	Cwsw_SwAlarmOvf__RetryAll();
+	if(!Cwsw_SwAlarmTable__Scan(pTbl, Cwsw_ClockSvc__TimerTic()))	{ return 0; }
+	return Cwsw_SwAlarmTable__Dispatch(pTbl);
+}
@@ -0,0 +1,330 @@
+/** @file
+ *	@brief	CWSW SW Alarm Tasks: periodic tasks dispatched by priority or by deadline.
+ *
+ *	Description:
+ *	Releases ride on the alarm scheduler: each task's alarm is periodic, anchored, and has a
+ *	callback in place of an event, so maturing it only marks the task's job ready. The count of
+ *	periods the alarm reports (kSwAlarmRearm_PostCount) tells the dispatcher how many releases were
+ *	lost to late service. A task holds at most one job; a release that finds the previous job still
+ *	waiting replaces it, since a periodic task's newest job is the one worth running.
+ *
+ *	Times are compared in nanoseconds on the clock's own timeline: monotonic nanoseconds with the
+ *	monotonic backend, and the current tic, scaled, otherwise.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <string.h>
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "cwsw_alarmtask.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Global Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/**	Current time, in nanoseconds on the clock's timeline. */
+static uint64_t
+task_now_ns(void)
+{
+#if (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_MONOTONIC)
+	return Cwsw_FastClock__NowNs();
+#else
+	return CWSW_CLOCK_TICS_TO_NS(Cwsw_ClockSvc__TimerTic());
+#endif
+}
+
+/**	Report a timing fault. */
+static void
+task_report(ptCwswSwAlarmTask pTask, tSwAlarmTaskMiss kind, uint64_t excess)
+{
+	ptCwswSwAlarmTaskSched pSched = pTask->pSched;
+
+	if(pSched && pSched->pfnMiss)	{ pSched->pfnMiss(pTask, kind, excess, pSched->pMissCtx); }
+}
+
+/**	Alarm callback: release a job. `evdata` is the number of periods that matured. */
+static void
+task_release(ptCwswSwAlarm pAlarm, uint32_t evdata, void *pCtx)
+{
+	ptCwswSwAlarmTask pTask = (ptCwswSwAlarmTask)pCtx;
+	uint32_t lost = (evdata > 1) ? (evdata - 1) : 0;
+
+	if(pTask->ready)	{ ++lost; }		// the waiting job is released over
+	if(lost)
+	{
+		pTask->stats.misses += lost;
+		task_report(pTask, kSwAlarmTaskMiss_Released, lost);
+	}
+
+	// the alarm has already rearmed, so the release just past is one period before its deadline.
+	pTask->release = Cwsw_TicsAfter(pAlarm->tm, -pTask->period);
+	pTask->due = Cwsw_TicsAfter(pTask->release, pTask->deadline);
+	pTask->ready = true;
+}
+
+/**	Does task `a` rank ahead of task `b` under the policy? */
+static bool
+task_ahead(tSwAlarmTaskPolicy policy, const tCwswSwAlarmTask *a, const tCwswSwAlarmTask *b)
+{
+	tCwswClockTics diff;
+
+	if(policy == kSwAlarmTask_EarliestDeadline)
+	{
+		diff = Cwsw_ElapsedTimeMs(a->due, b->due);
+		if(diff)	{ return diff > 0; }
+	}
+	if(a->period != b->period)		{ return a->period < b->period; }
+	if(a->deadline != b->deadline)	{ return a->deadline < b->deadline; }
+	return a->order < b->order;
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+/**	Initialize an empty task scheduler.
+ *	@param [out]	pSched	Scheduler.
+ *	@param [in]		policy	Order in which ready jobs run.
+ *	@returns Error code, where 0 is no error.
+ */
+tErrorCodes_SwTmr
+Cwsw_SwAlarmTask__InitSched(ptCwswSwAlarmTaskSched pSched, tSwAlarmTaskPolicy policy)
+{
+	if(!pSched || (policy > kSwAlarmTask_EarliestDeadline))	{ return kErr_SwTmr_BadParm; }
+
+	memset(pSched, 0, sizeof(*pSched));
+	pSched->policy = policy;
+	return Cwsw_SwAlarmSched__Init(&pSched->alarms);
+}
+
+
+/**	Set the handler for timing faults: late jobs, lost jobs and budget overruns. NULL for none;
+ *	faults are counted in each task's statistics either way.
+ */
+void
+Cwsw_SwAlarmTask__SetMissHandler(ptCwswSwAlarmTaskSched pSched, pfCwswSwAlarmTaskMiss pfnMiss, void *pCtx)
+{
+	if(!pSched)		{ return; }
+
+	pSched->pfnMiss = pfnMiss;
+	pSched->pMissCtx = pCtx;
+}
+
+
+/**	Initialize a periodic task.
+ *
+ *	@param [out]	pTask		Task.
+ *	@param [in]		pfnRun		Job function.
+ *	@param [in]		pCtx		Context for the job function.
+ *	@param [in]		period		Tics between releases; must be positive.
+ *	@param [in]		deadline	Tics after release by which each job must complete; 0 for the
+ *								period. At most the period.
+ *	@param [in]		budgetns	Execution time allowed each job, in ns; 0 for no budget.
+ *	@param [in]		id			Identifier for reports.
+ *	@returns Error code, where 0 is no error.
+ */
+tErrorCodes_SwTmr
+Cwsw_SwAlarmTask__Init(
+	ptCwswSwAlarmTask		pTask,
+	pfCwswSwAlarmTaskFn		pfnRun,
+	void					*pCtx,
+	tCwswClockTics			period,
+	tCwswClockTics			deadline,
+	uint64_t				budgetns,
+	uint16_t				id)
+{
+	if(!pTask || !pfnRun || (period <= 0))		{ return kErr_SwTmr_BadParm; }
+	if((deadline < 0) || (deadline > period))	{ return kErr_SwTmr_BadParm; }
+
+	memset(pTask, 0, sizeof(*pTask));
+	pTask->pfnRun = pfnRun;
+	pTask->pCtx = pCtx;
+	pTask->period = period;
+	pTask->deadline = deadline ? deadline : period;
+	pTask->budgetns = budgetns;
+	pTask->id = id;
+
+	(void)Cwsw_SwAlarm__Init(&pTask->alarm, period, period, NULL, 0);
+	Cwsw_SwAlarm__SetRearmPolicy(&pTask->alarm, kSwAlarmRearm_PostCount);
+	Cwsw_SwAlarm__SetCallback(&pTask->alarm, task_release, pTask);
+	return kErr_SwTmr_NoError;
+}
+
+
+/**	Add a task to a scheduler, and start releasing its jobs.
+ *	Releases fall on the tics `phase` + k * period, as for Cwsw_SwAlarmSched__ArmAligned(); tasks
+ *	with harmonic periods and a common phase are released together.
+ *
+ *	@param [in,out]	pSched	Scheduler.
+ *	@param [in,out]	pTask	Task, initialized and not yet added to any scheduler.
+ *	@param [in]		phase	Any raw tic on the task's release grid.
+ *	@returns Error code, where 0 is no error.
+ */
+tErrorCodes_SwTmr
+Cwsw_SwAlarmTask__Add(ptCwswSwAlarmTaskSched pSched, ptCwswSwAlarmTask pTask, tCwswClockTics phase)
+{
+	if(!pSched || !pTask || !pTask->pfnRun || pTask->pSched)	{ return kErr_SwTmr_BadParm; }
+
+	pTask->ready = false;
+	pTask->order = pSched->nextorder++;
+	pTask->pSched = pSched;
+	pTask->pNext = pSched->pTasks;
+	pSched->pTasks = pTask;
+	return Cwsw_SwAlarmSched__ArmAligned(&pSched->alarms, &pTask->alarm, pTask->period, phase);
+}
+
+
+/**	Remove a task from its scheduler; a job waiting to run is discarded. */
+void
+Cwsw_SwAlarmTask__Remove(ptCwswSwAlarmTask pTask)
+{
+	ptCwswSwAlarmTask *ppLink;
+
+	if(!pTask || !pTask->pSched)	{ return; }
+
+	Cwsw_SwAlarmSched__Cancel(&pTask->pSched->alarms, &pTask->alarm);
+	for(ppLink = &pTask->pSched->pTasks; *ppLink; ppLink = &(*ppLink)->pNext)
+	{
+		if(*ppLink == pTask)
+		{
+			*ppLink = pTask->pNext;
+			break;
+		}
+	}
+	pTask->pNext = NULL;
+	pTask->pSched = NULL;
+	pTask->ready = false;
+}
+
+
+/**	Read a task's timing record.
+ *	@param [in,out]	pTask	Task.
+ *	@param [out]	pStats	Timing record.
+ *	@param [in]		reset	Start the record over.
+ */
+void
+Cwsw_SwAlarmTask__GetStats(ptCwswSwAlarmTask pTask, ptCwswSwAlarmTaskStats pStats, bool reset)
+{
+	if(!pTask || !pStats)	{ return; }
+
+	*pStats = pTask->stats;
+	if(reset)	{ memset(&pTask->stats, 0, sizeof(pTask->stats)); }
+}
+
+
+/**	Release every job due by the current tic, then run the most urgent ready job.
+ *	Call once per pass through the main loop, after Cwsw_ClockSvc__Task().
+ *
+ *	@returns The task whose job ran; NULL if none was ready.
+ */
+ptCwswSwAlarmTask
+Cwsw_SwAlarmTask__Dispatch(ptCwswSwAlarmTaskSched pSched)
+{
+	ptCwswSwAlarmTask pBest = NULL;
+	ptCwswSwAlarmTask pTask;
+	uint64_t start;
+	uint64_t ns;
+
+	if(!pSched)		{ return NULL; }
+
+	(void)Cwsw_SwAlarmSched__Advance(&pSched->alarms, Cwsw_ClockSvc__TimerTic());
+
+	for(pTask = pSched->pTasks; pTask; pTask = pTask->pNext)
+	{
+		if(pTask->ready && (!pBest || task_ahead(pSched->policy, pTask, pBest)))	{ pBest = pTask; }
+	}
+	if(!pBest)		{ return NULL; }
+
+	pBest->ready = false;
+	start = task_now_ns();
+	ns = CWSW_CLOCK_TICS_TO_NS(pBest->release);
+	if((start > ns) && ((start - ns) > pBest->stats.maxlatens))	{ pBest->stats.maxlatens = start - ns; }
+
+	pBest->pfnRun(pBest, pBest->pCtx);
+
+	ns = task_now_ns();
+	++pBest->stats.jobs;
+	if((ns - start) > pBest->stats.maxexecns)	{ pBest->stats.maxexecns = ns - start; }
+
+	if(pBest->budgetns && ((ns - start) > pBest->budgetns))
+	{
+		++pBest->stats.overruns;
+		task_report(pBest, kSwAlarmTaskMiss_Budget, (ns - start) - pBest->budgetns);
+	}
+	if(ns > CWSW_CLOCK_TICS_TO_NS(pBest->due))
+	{
+		++pBest->stats.misses;
+		task_report(pBest, kSwAlarmTaskMiss_Deadline, ns - CWSW_CLOCK_TICS_TO_NS(pBest->due));
+	}
+	return pBest;
+}
+
+
+/**	Run ready jobs, most urgent first, until none is ready.
+ *	Jobs released while others run are taken into account only if the clock is serviced by another
+ *	thread; otherwise, prefer one call to Cwsw_SwAlarmTask__Dispatch() per pass of the main loop.
+ *
+ *	@returns Number of jobs run.
+ */
+uint32_t
+Cwsw_SwAlarmTask__Task(ptCwswSwAlarmTaskSched pSched)
+{
+	uint32_t njobs = 0;
+
+	while(Cwsw_SwAlarmTask__Dispatch(pSched))	{ ++njobs; }
+	return njobs;
+}
+
+
+/**	Find the tic by which the dispatcher next has work: now, if a job is ready; otherwise the next
+ *	release. For Cwsw_ClockSvc__SetWakeup() or Cwsw_ClockSvc__WaitUntil().
+ *
+ *	@returns true if there is work to come; false if the scheduler has no tasks.
+ */
+bool
+Cwsw_SwAlarmTask__NextWake(ptCwswSwAlarmTaskSched pSched, pCwswClockTics pTic)
+{
+	ptCwswSwAlarmTask pTask;
+
+	if(!pSched || !pTic)	{ return false; }
+
+	for(pTask = pSched->pTasks; pTask; pTask = pTask->pNext)
+	{
+		if(pTask->ready)
+		{
+			*pTic = pSched->alarms.curtic;
+			return true;
+		}
+	}
+	return Cwsw_SwAlarmSched__NextDeadline(&pSched->alarms, pTic);
+}
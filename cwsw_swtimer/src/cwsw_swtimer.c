@@ -19,6 +19,8 @@
 
 // ----	Module Headers --------------------------
 #include "cwsw_swtimer.h"
+#include "cwsw_alarmovf.h"
+#include "cwsw_trace.h"
 
 
 // ============================================================================
@@ -37,10 +39,51 @@
 // ----	Module-level Variables ------------------------------------------------
 // ============================================================================
 
+#if (CWSW_CLOCK_HISTOGRAMS)
+static tCwswTicHist		swalarm_hist[kNumSwAlarmHist];
+#endif
+
 // ============================================================================
 // ----	Private Functions -----------------------------------------------------
 // ============================================================================
 
+/**	Post a SW alarm's event, with the specified event data.
+ *	If the alarm has a callback, it is run right here instead, whether or not a batch is in use.
+ *	Otherwise, if a batch is supplied, the event is appended to it; a full batch is committed first.
+ */
+static void
+swalarm_post(ptCwswSwAlarm pTimer, uint32_t evdata, tCwswClockTics deadline, ptCwswSwAlarmBatch pBatch)
+{
+	tEvQ_Event ev;
+
+	if(pTimer->pfnCallback)
+	{
+#if (CWSW_CLOCK_HISTOGRAMS) && (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_MONOTONIC)
+		CWSW_TICHIST_RECORD(swalarm_hist[kSwAlarmHist_CallbackNs],
+			Cwsw_FastClock__NowNs() - CWSW_CLOCK_TICS_TO_NS(deadline));
+#else
+		(void)deadline;
+#endif
+		pTimer->pfnCallback(pTimer, evdata, pTimer->pCtx);
+		return;
+	}
+
+	ev.evId = (tEvQ_EventID)pTimer->evid;
+	ev.evData = evdata;
+
+	if(pBatch && pBatch->capacity)
+	{
+		if(pBatch->count >= pBatch->capacity)	{ (void)Cwsw_SwAlarm__CommitBatch(pBatch); }
+		pBatch->pEntries[pBatch->count].pEvQX = pTimer->pEvQX;
+		pBatch->pEntries[pBatch->count].ev = ev;
+		++pBatch->count;
+		return;
+	}
+
+	// a failed post is held or counted by the delivery path; see cwsw_alarmovf.h.
+	(void)Cwsw_SwAlarm__Deliver(pTimer->pEvQX, ev);	// don't need to check for valid queue ctrl, 'cuz it does its own checking
+}
+
 // ============================================================================
 // ----	Public Functions ------------------------------------------------------
 // ============================================================================
@@ -68,6 +111,15 @@ Cwsw_SwAlarm__Init(
 		pTimer->pEvQX = pEvQX;
 		pTimer->evid = evid;
 		pTimer->tmrstate = kTmrState_Disabled;
+		pTimer->rearm = kSwAlarmRearm_FromService;
+		pTimer->slack = 0;
+		pTimer->pfnCallback = NULL;
+		pTimer->pCtx = NULL;
+		pTimer->pNext = NULL;
+		pTimer->ppPrev = NULL;
+		pTimer->seq = 0;
+		pTimer->pGroupNext = NULL;
+		pTimer->pGroup = NULL;
 		return kErr_SwTmr_NoError;
 	}
 
@@ -75,10 +127,107 @@ Cwsw_SwAlarm__Init(
 }
 
 
+/**	Set a polled alarm's state.
+ *	Pausing and resuming go through Cwsw_SwAlarm__Pause() and Cwsw_SwAlarm__Resume(), so `tm` keeps
+ *	its meaning: a deadline, except while the alarm is paused, when it holds the tics left. Disabling
+ *	a paused alarm turns its time left back into a deadline; enabling a disabled alarm takes `tm` as
+ *	its deadline. Unknown states are ignored.
+ */
 void
 Cwsw_SwAlarm__SetState(ptCwswSwAlarm pTimer, tSwTimerState newstate)
 {
-	if(pTimer)	{ pTimer->tmrstate = newstate; }
+	if(!pTimer)	{ return; }
+
+	switch(newstate)
+	{
+	case kTmrState_Paused:
+		Cwsw_SwAlarm__Pause(pTimer);
+		break;
+
+	case kTmrState_Enabled:
+		if(pTimer->tmrstate == kTmrState_Paused)	{ Cwsw_SwAlarm__Resume(pTimer); }
+		else										{ pTimer->tmrstate = kTmrState_Enabled; }
+		break;
+
+	case kTmrState_Disabled:
+		if(pTimer->tmrstate == kTmrState_Paused)
+		{
+			pTimer->tm = Cwsw_TicsAfter(Cwsw_ClockSvc__TimerTic(), pTimer->tm);
+		}
+		pTimer->tmrstate = kTmrState_Disabled;
+		break;
+
+	default:
+		break;
+	}
+}
+
+
+/**	Select how a periodic alarm computes its next deadline.
+ *	Takes effect at the next maturation. See tSwAlarmRearm.
+ */
+void
+Cwsw_SwAlarm__SetRearmPolicy(ptCwswSwAlarm pTimer, tSwAlarmRearm policy)
+{
+	if(pTimer)	{ pTimer->rearm = policy; }
+}
+
+
+/**	Allow an alarm to mature up to `slack` tics late.
+ *	The alarm scheduler uses the slack to move the alarm onto a tic shared with other alarms, so the
+ *	system services fewer, larger batches. A periodic alarm with an anchored rearm policy keeps its
+ *	nominal period; slack delays each maturation, but never accumulates. Keep the slack shorter than
+ *	the period. Other ways of servicing alarms ignore it.
+ */
+void
+Cwsw_SwAlarm__SetSlack(ptCwswSwAlarm pTimer, tCwswClockTics slack)
+{
+	if(pTimer && (slack >= 0))	{ pTimer->slack = slack; }
+}
+
+
+/**	Select direct dispatch for an alarm.
+ *	With a callback set, the alarm's maturation runs the callback inline, from whichever context
+ *	services the alarm (the polling loop, or the scheduler's task), instead of posting an event for
+ *	a consumer to dequeue and dispatch. The callback must be brief; it delays every alarm serviced
+ *	after it. Pass NULL to revert to posting the alarm's event.
+ */
+void
+Cwsw_SwAlarm__SetCallback(ptCwswSwAlarm pTimer, pfCwswSwAlarmCallback pfnCallback, void *pCtx)
+{
+	if(!pTimer)		{ return; }
+
+	pTimer->pfnCallback = pfnCallback;
+	pTimer->pCtx = pCtx;
+}
+
+
+/**	Pause an enabled alarm, freezing the time it has left.
+ *	While paused, the alarm's `tm` holds the remaining tics rather than a deadline, and the alarm
+ *	is ignored by Cwsw_SwAlarm__ManageTimer(). Pausing an alarm that isn't enabled has no effect.
+ *	For alarms registered with a scheduler, use Cwsw_SwAlarmSched__Pause() instead.
+ */
+void
+Cwsw_SwAlarm__Pause(ptCwswSwAlarm pTimer)
+{
+	if(!pTimer || (pTimer->tmrstate != kTmrState_Enabled))	{ return; }
+
+	pTimer->tm = Cwsw_GetTimeLeft(pTimer->tm);
+	pTimer->tmrstate = kTmrState_Paused;
+}
+
+
+/**	Resume a paused alarm with the time it had left when it was paused.
+ *	An alarm paused after its deadline had already arrived matures on its next service.
+ *	Resuming an alarm that isn't paused has no effect.
+ */
+void
+Cwsw_SwAlarm__Resume(ptCwswSwAlarm pTimer)
+{
+	if(!pTimer || (pTimer->tmrstate != kTmrState_Paused))	{ return; }
+
+	pTimer->tm = Cwsw_TicsAfter(Cwsw_ClockSvc__TimerTic(), pTimer->tm);
+	pTimer->tmrstate = kTmrState_Enabled;
 }
 
 
@@ -105,37 +254,180 @@ Cwsw_SwAlarm__SetState(ptCwswSwAlarm pTimer, tSwTimerState newstate)
 void
 Cwsw_SwAlarm__ManageTimer(ptCwswSwAlarm pTimer)
 {
-	tCwswClockTics exptm;
-	tErrorCodes_EvQ err;
-	tEvQ_Event ev;
-
 	if(!pTimer)										{ return; }
-	if(!(pTimer->tmrstate == kTmrState_Enabled))	{ return; }		// for now, MVP is to handle only an enabled timer
+	if(!(pTimer->tmrstate == kTmrState_Enabled))	{ return; }		// disabled or paused timers don't mature
 	if(Get(Cwsw_Clock, pTimer->tm) > 0)				{ return; }		// timer's not expired yet
 
+	Cwsw_SwAlarm__Mature(pTimer, NULL, Cwsw_ClockSvc__TimerTic());
+
+	// note: a paused timer holds its remaining time, not a deadline; see Cwsw_SwAlarm__Pause().
+}
+
+
+/**	React to the maturation of one SW alarm.
+ *	Common to both the polled path (Cwsw_SwAlarm__ManageTimer()) and the alarm scheduler: rearm the
+ *	timer if it has a reload value, and post its event, if any.
+ *
+ *	For the anchored rearm policies, the next deadline is the first multiple of the reload time
+ *	past the expired deadline that is still in the future; any whole periods that elapsed while the
+ *	alarm awaited service are reported according to the policy.
+ *
+ *	@param [in,out] pTimer	SW Timer that has matured. The caller has already established that the
+ *							timer is enabled and expired.
+ *	@param [in,out] pBatch	Batch to collect the alarm's event(s) into, or NULL to post directly.
+ *	@param [in]		now		Tic at which the alarm is being serviced. Normally the current clock
+ *							tic; a simulated clock passes its own virtual time.
+ */
+void
+Cwsw_SwAlarm__Mature(ptCwswSwAlarm pTimer, ptCwswSwAlarmBatch pBatch, tCwswClockTics now)
+{
+	tCwswClockTics exptm;
+	tCwswClockTics nexttm;
+	tCwswClockTics nperiods = 1;
+	tCwswClockTics late;
+
+	if(!pTimer)									{ return; }
+
 	// save target value to pass as argument to reaction task
 	exptm = pTimer->tm;
+	late = Cwsw_ElapsedTimeMs(exptm, now);
+	CWSW_TICHIST_RECORD(swalarm_hist[kSwAlarmHist_Lateness], late);
+	CWSW_TRACE((late > 0) ? kCwswTrace_AlarmLate : kCwswTrace_AlarmFired, pTimer->evid, (late > 0) ? late : 0);
+	(void)late;		// used only by instrumentation, which may be compiled out
 
 	// rearm timer
 	if(pTimer->reloadtm > 0)
 	{
-		Cwsw_ClockSvc__SetTimer(&pTimer->tm, pTimer->reloadtm);
+		if(pTimer->rearm == kSwAlarmRearm_FromService)
+		{
+			pTimer->tm = Cwsw_TicsAfter(now, pTimer->reloadtm);
+		}
+		else
+		{
+			nperiods += Cwsw_ElapsedTimeMs(exptm, now) / pTimer->reloadtm;
+			pTimer->tm = Cwsw_TicsAfter(exptm, nperiods * pTimer->reloadtm);
+		}
 	}
 
 	// if there's no callback, we're done
-	if(!pTimer->evid)							{ return; }
+	if(!pTimer->evid && !pTimer->pfnCallback)	{ return; }
 
-	ev.evId = (tEvQ_EventID)pTimer->evid;
-	ev.evData = TO_U32(exptm);
-	err = Cwsw_EvQX__PostEvent(pTimer->pEvQX, ev);	// don't need to check for valid queue ctrl, 'cuz it does its own checking
+	switch(pTimer->rearm)
+	{
+	case kSwAlarmRearm_PostEach:
+		nexttm = pTimer->tm;
+		while(nperiods--)
+		{
+			swalarm_post(pTimer, TO_U32(exptm), exptm, pBatch);
+			// a callback that disables, pauses, re-arms or releases its alarm gets no more catch-ups.
+			if((pTimer->tmrstate != kTmrState_Enabled) || (pTimer->tm != nexttm))	{ break; }
+			exptm = Cwsw_TicsAfter(exptm, pTimer->reloadtm);
+		}
+		break;
+
+	case kSwAlarmRearm_PostCount:
+		swalarm_post(pTimer, TO_U32(nperiods), exptm, pBatch);
+		break;
+
+	case kSwAlarmRearm_FromService:
+	case kSwAlarmRearm_SkipMissed:
+	default:
+		swalarm_post(pTimer, TO_U32(exptm), exptm, pBatch);
+		break;
+	}
+}
+
+
+/**	Post one alarm event to its event queue.
+ *	Every alarm event, whether posted as its alarm matures or from a batch, goes through here; this
+ *	is the one place to instrument delivery.
+ *
+ *	If the queue has an overflow buffer, events it holds are posted first, and an event that can't
+ *	be posted is held in its turn; see cwsw_alarmovf.h.
+ *
+ *	@returns 0 if the event was posted or held; otherwise the event queue's error code, and the
+ *	event is lost.
+ */
+tErrorCodes_EvQ
+Cwsw_SwAlarm__Deliver(ptEvQ_QueueCtrlEx pEvQX, tEvQ_Event ev)
+{
+	ptCwswSwAlarmOverflow pOvf = Cwsw_SwAlarmOvf__Find(pEvQX);
+	tErrorCodes_EvQ err;
+
+	// events already held go first, so the queue sees its events in order. if they can't all be
+	// posted, this one waits behind them; should it then be dropped, the failed post's error says so.
+	err = Cwsw_SwAlarmOvf__Retry(pOvf);
 	if(err)
 	{
-		err = ~0;	// to allow setting a breakpoint here
+		return Cwsw_SwAlarmOvf__Defer(pOvf, ev, err);
 	}
 
-	// else if paused: ...
-	// note: "pause" doesn't tread water; it does not make the timeout value keep pace with the
-	//	current time. upon resumption, it is highly probable that the timer will immediately
-	//	mature.
+#if (CWSW_CLOCK_HISTOGRAMS) && (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_MONOTONIC)
+	uint64_t start = Cwsw_FastClock__NowNs();
+
+	err = Cwsw_EvQX__PostEvent(pEvQX, ev);
+	CWSW_TICHIST_RECORD(swalarm_hist[kSwAlarmHist_PostNs], Cwsw_FastClock__NowNs() - start);
+#else
+	err = Cwsw_EvQX__PostEvent(pEvQX, ev);
+#endif
+
+	CWSW_TRACE(err ? kCwswTrace_EvPostFailed : kCwswTrace_EvPosted, ev.evId, err);
+	return err ? Cwsw_SwAlarmOvf__Defer(pOvf, ev, err) : err;
+}
+
+
+/**	Initialize a batch of alarm events over caller-supplied storage.
+ *
+ *	@param [out]	pBatch		Batch to initialize.
+ *	@param [in]		pEntries	Storage for the batch.
+ *	@param [in]		capacity	Number of entries in the storage.
+ *	@returns Error code, where 0 is no error.
+ */
+tErrorCodes_SwTmr
+Cwsw_SwAlarm__InitBatch(ptCwswSwAlarmBatch pBatch, ptSwAlarmBatchEntry pEntries, uint16_t capacity)
+{
+	if(!pBatch || !pEntries || !capacity)	{ return kErr_SwTmr_BadParm; }
+
+	pBatch->pEntries = pEntries;
+	pBatch->capacity = capacity;
+	pBatch->count = 0;
+	return kErr_SwTmr_NoError;
+}
+
 
+/**	Deliver every event collected in a batch, in the order collected, and empty the batch.
+ *	Delivery is one tight pass over contiguous storage, rather than being interleaved with the
+ *	rearm and bookkeeping work of each alarm.
+ *
+ *	@returns Error code, where 0 is no error; kErr_SwTmr_PostFailed if any event could not be posted.
+ */
+tErrorCodes_SwTmr
+Cwsw_SwAlarm__CommitBatch(ptCwswSwAlarmBatch pBatch)
+{
+	tErrorCodes_SwTmr rc = kErr_SwTmr_NoError;
+	ptSwAlarmBatchEntry pEntry;
+	ptSwAlarmBatchEntry pEnd;
+
+	if(!pBatch)		{ return kErr_SwTmr_BadParm; }
+
+	pEnd = pBatch->pEntries + pBatch->count;
+	for(pEntry = pBatch->pEntries; pEntry < pEnd; ++pEntry)
+	{
+		if(Cwsw_SwAlarm__Deliver(pEntry->pEvQX, pEntry->ev))	{ rc = kErr_SwTmr_PostFailed; }
+	}
+	pBatch->count = 0;
+	return rc;
+}
+
+
+#if (CWSW_CLOCK_HISTOGRAMS)
+/**	Access one of the SW alarm histograms; summarize it with Cwsw_TicHist__Snapshot().
+ *	@returns The histogram, or NULL for an invalid selection.
+ */
+ptCwswTicHist
+Cwsw_SwAlarm__Histogram(enum eSwAlarmHist which)
+{
+	if(which >= kNumSwAlarmHist)	{ return NULL; }
+	return &swalarm_hist[which];
 }
+#endif
@@ -0,0 +1,204 @@
+/** @file
+ *	@brief	Benchmark: cost of the clock services and SW alarm primitives, and of servicing one tic.
+ *
+ *	Prints one line of JSON per case (see Cwsw_PerfCtr__Format()):
+ *	- `TimerTic`, `SetTimer`: the clock services calls every alarm operation makes.
+ *	- `ManageTimer/idle`, `/expired`, `/rearm`: one polled alarm that isn't due, that is due (a
+ *	  one-shot), and that is due and periodic.
+ *	- `Tic/polled`, `Tic/sched`: one whole tic (Cwsw_ClockSvc__Task() plus servicing every alarm)
+ *	  with 1 to 1M periodic alarms, by Cwsw_SwAlarm__ManageTimer() on each, and by the alarm
+ *	  scheduler. `param` is the number of alarms.
+ *
+ *	Events go to a stub queue that discards them, so only the alarms' own cost is measured. Runs on
+ *	the simulated clock, so every run services the same tics.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdio.h>
+#include <stdlib.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_clock.h"
+#include "cwsw_perfctr.h"
+#include "stub_evqueue.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_swtimer.h"
+#include "cwsw_alarmsched.h"
+
+#if (CWSW_CLOCK_BACKEND != CWSW_CLOCK_BACKEND_SIM)
+#error "The alarm benchmark runs on the simulated clock."
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum {
+	kBench_Ops			= 10000000,		//!< Calls per primitive measured.
+	kBench_AlarmTics	= 20000000,		//!< Alarm services per tic case (tics x alarms), at least.
+	kBench_MinTics		= 16,			//!< Fewest tics measured in a tic case.
+	kBench_MaxPeriod	= 1000			//!< Longest alarm period in a tic case, in tics.
+};
+
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+static tCwswPerfCtr ctr;
+static tStubEvQ discard;
+static ptEvQ_QueueCtrlEx pDiscard;
+static volatile tCwswClockTics sink;	//!< Keeps measured results alive.
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+static void
+report(const char *name, uint64_t param, const tCwswPerfSample *pSample)
+{
+	char line[256];
+
+	(void)Cwsw_PerfCtr__Format(line, sizeof(line), name, param, pSample);
+	puts(line);
+}
+
+static void
+bench_primitives(void)
+{
+	tCwswPerfSample sample;
+	tCwswSwAlarm alarm;
+	tCwswClockTics tm;
+	uint32_t i;
+
+	Cwsw_PerfCtr__Start(&ctr);
+	for(i = 0; i < kBench_Ops; ++i)	{ sink = Cwsw_ClockSvc__TimerTic(); }
+	Cwsw_PerfCtr__Stop(&ctr, &sample, kBench_Ops);
+	report("TimerTic", 1, &sample);
+
+	Cwsw_PerfCtr__Start(&ctr);
+	for(i = 0; i < kBench_Ops; ++i)	{ (void)Cwsw_ClockSvc__SetTimer(&tm, (tCwswClockTics)(i & 0xFF)); sink = tm; }
+	Cwsw_PerfCtr__Stop(&ctr, &sample, kBench_Ops);
+	report("SetTimer", 1, &sample);
+
+	// not yet due.
+	(void)Cwsw_SwAlarm__Init(&alarm, 0, 0, pDiscard, 1);
+	(void)Cwsw_ClockSvc__SetTimer(&alarm.tm, 1000000);
+	Cwsw_SwAlarm__SetState(&alarm, kTmrState_Enabled);
+	Cwsw_PerfCtr__Start(&ctr);
+	for(i = 0; i < kBench_Ops; ++i)	{ Cwsw_SwAlarm__ManageTimer(&alarm); }
+	Cwsw_PerfCtr__Stop(&ctr, &sample, kBench_Ops);
+	report("ManageTimer/idle", 1, &sample);
+
+	// a one-shot stays due until disabled, so it matures on every call.
+	alarm.tm = Cwsw_ClockSvc__TimerTic();
+	Cwsw_PerfCtr__Start(&ctr);
+	for(i = 0; i < kBench_Ops; ++i)	{ Cwsw_SwAlarm__ManageTimer(&alarm); }
+	Cwsw_PerfCtr__Stop(&ctr, &sample, kBench_Ops);
+	report("ManageTimer/expired", 1, &sample);
+
+	// periodic; made due again before each call.
+	alarm.reloadtm = 10;
+	Cwsw_PerfCtr__Start(&ctr);
+	for(i = 0; i < kBench_Ops; ++i)
+	{
+		alarm.tm = Cwsw_ClockSvc__TimerTic();
+		Cwsw_SwAlarm__ManageTimer(&alarm);
+	}
+	Cwsw_PerfCtr__Stop(&ctr, &sample, kBench_Ops);
+	report("ManageTimer/rearm", 1, &sample);
+}
+
+/**	Set up `n` periodic alarms, with periods spread over 1..kBench_MaxPeriod tics. */
+static void
+tic_alarms(ptCwswSwAlarm pAlarms, uint32_t n, ptCwswSwAlarmSched pSched)
+{
+	tCwswClockTics period;
+	uint32_t i;
+
+	for(i = 0; i < n; ++i)
+	{
+		period = 1 + (tCwswClockTics)((i * 7919UL) % kBench_MaxPeriod);
+		(void)Cwsw_SwAlarm__Init(&pAlarms[i], 0, period, pDiscard, 1);
+		if(pSched)
+		{
+			(void)Cwsw_SwAlarmSched__Arm(pSched, &pAlarms[i], period);
+		}
+		else
+		{
+			(void)Cwsw_ClockSvc__SetTimer(&pAlarms[i].tm, period);
+			Cwsw_SwAlarm__SetState(&pAlarms[i], kTmrState_Enabled);
+		}
+	}
+}
+
+static void
+bench_tic(uint32_t n)
+{
+	static tCwswSwAlarmSched sched;
+	tCwswPerfSample sample;
+	ptCwswSwAlarm pAlarms = calloc(n, sizeof(*pAlarms));
+	uint32_t ntics = kBench_AlarmTics / n;
+	uint32_t tic;
+	uint32_t i;
+
+	if(!pAlarms)	{ return; }
+	if(ntics < kBench_MinTics)	{ ntics = kBench_MinTics; }
+
+	tic_alarms(pAlarms, n, NULL);
+	Cwsw_PerfCtr__Start(&ctr);
+	for(tic = 0; tic < ntics; ++tic)
+	{
+		(void)Cwsw_ClockSvc__Task();
+		for(i = 0; i < n; ++i)	{ Cwsw_SwAlarm__ManageTimer(&pAlarms[i]); }
+	}
+	Cwsw_PerfCtr__Stop(&ctr, &sample, ntics);
+	report("Tic/polled", n, &sample);
+
+	(void)Cwsw_SwAlarmSched__Init(&sched);
+	tic_alarms(pAlarms, n, &sched);
+	Cwsw_PerfCtr__Start(&ctr);
+	for(tic = 0; tic < ntics; ++tic)
+	{
+		(void)Cwsw_ClockSvc__Task();
+		(void)Cwsw_SwAlarmSched__Task(&sched);
+	}
+	Cwsw_PerfCtr__Stop(&ctr, &sample, ntics);
+	report("Tic/sched", n, &sample);
+
+	free(pAlarms);
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+int
+main(void)
+{
+	uint32_t n;
+
+	pDiscard = Cwsw_StubEvQ__Init(&discard, NULL, 0);
+	Cwsw_ClockSvc__Init(NULL, 0);
+	(void)Cwsw_PerfCtr__Open(&ctr);
+
+	bench_primitives();
+	for(n = 1; n <= 1000000; n *= 10)	{ bench_tic(n); }
+
+	Cwsw_PerfCtr__Close(&ctr);
+	return 0;
+}
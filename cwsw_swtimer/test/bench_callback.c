@@ -0,0 +1,206 @@
+/** @file
+ *	@brief	Benchmark: expiry-to-handler latency of direct callbacks, against delivery by event queue.
+ *
+ *	Each tic starts a service pass: Cwsw_ClockSvc__Task() then Cwsw_SwAlarm__ManageTimer() on every
+ *	alarm. Latency is the time from the start of the pass to the start of each matured alarm's
+ *	handler:
+ *	- `Latency/callback`: each alarm has a callback (Cwsw_SwAlarm__SetCallback()), which is the
+ *	  handler, and runs as the alarm matures.
+ *	- `Latency/queue`: each alarm posts its event to a stub queue; once every alarm has been serviced,
+ *	  the consumer takes the events one at a time and looks up each one's handler by event ID, as
+ *	  tedlos does.
+ *
+ *	`param` is the number of periodic alarms (1 to 1k, with periods of 1 to 8 tics). Prints one line
+ *	of JSON per case with the 50th and 99th percentile and the worst latency, in nanoseconds. The
+ *	same handler runs in both modes, and both include one read of the clock.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdio.h>
+#include <stdlib.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_clock.h"
+#include "cwsw_perfctr.h"
+#include "stub_evqueue.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_swtimer.h"
+
+#if (CWSW_CLOCK_BACKEND != CWSW_CLOCK_BACKEND_SIM)
+#error "The callback benchmark runs on the simulated clock."
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum {
+	kBench_AlarmTics	= 2000000,		//!< Alarm services per case (tics x alarms).
+	kBench_MaxPeriod	= 8,			//!< Longest alarm period, in tics.
+	kBench_Events		= 16			//!< Distinct event IDs, each with its own handler.
+};
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/**	An event handler, as looked up by the consumer of the queue. */
+typedef void (*pfBenchHandler)(uint32_t evdata);
+
+/**	Latencies recorded in one case. */
+typedef struct sBenchLatency {
+	uint64_t	*pNs;		/**< One per handler run. */
+	uint32_t	capacity;
+	uint32_t	count;
+} tBenchLatency;
+
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+static tBenchLatency lat;
+static uint64_t passns;		//!< Start of the current service pass.
+static volatile uint32_t sink;		//!< Keeps handlers' work alive.
+
+static tEvQ_Event *pRing;
+static tStubEvQ queue;
+static ptEvQ_QueueCtrlEx pQueue;
+static pfBenchHandler handlers[kBench_Events + 1];	//!< Indexed by event ID; 0 is unused.
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/**	The handler: record its latency. */
+static void
+handler(uint32_t evdata)
+{
+	if(lat.count < lat.capacity)	{ lat.pNs[lat.count++] = Cwsw_PerfCtr__NowNs() - passns; }
+	sink = evdata;
+}
+
+/**	Direct callback; runs the handler in place of posting the event. */
+static void
+alarm_callback(struct sSwTimer *pAlarm, uint32_t evdata, void *pCtx)
+{
+	(void)pAlarm;
+	(void)pCtx;
+	handler(evdata);
+}
+
+static int
+cmp_ns(const void *pA, const void *pB)
+{
+	uint64_t a = *(const uint64_t *)pA;
+	uint64_t b = *(const uint64_t *)pB;
+
+	return (a > b) - (a < b);
+}
+
+static void
+report(const char *name, uint32_t n)
+{
+	uint64_t p50 = 0, p99 = 0, max = 0;
+
+	if(lat.count)
+	{
+		qsort(lat.pNs, lat.count, sizeof(lat.pNs[0]), cmp_ns);
+		p50 = lat.pNs[(lat.count - 1) / 2];
+		p99 = lat.pNs[((uint64_t)(lat.count - 1) * 99) / 100];
+		max = lat.pNs[lat.count - 1];
+	}
+	printf("{\"bench\":\"%s\",\"param\":%u,\"samples\":%u,\"p50_ns\":%llu,\"p99_ns\":%llu,\"max_ns\":%llu}\n",
+		name, n, lat.count, (unsigned long long)p50, (unsigned long long)p99, (unsigned long long)max);
+}
+
+/**	Set up `n` periodic alarms, each with one of the handlers' event IDs. */
+static void
+bench_alarms(ptCwswSwAlarm pAlarms, uint32_t n, bool callback)
+{
+	tCwswClockTics period;
+	uint32_t i;
+
+	for(i = 0; i < n; ++i)
+	{
+		period = 1 + (tCwswClockTics)(i % kBench_MaxPeriod);
+		(void)Cwsw_SwAlarm__Init(&pAlarms[i], 0, period, pQueue, (int16_t)(1 + (i % kBench_Events)));
+		if(callback)	{ Cwsw_SwAlarm__SetCallback(&pAlarms[i], alarm_callback, NULL); }
+		(void)Cwsw_ClockSvc__SetTimer(&pAlarms[i].tm, period);
+		Cwsw_SwAlarm__SetState(&pAlarms[i], kTmrState_Enabled);
+	}
+}
+
+static void
+bench_latency(uint32_t n)
+{
+	ptCwswSwAlarm pAlarms = calloc(n, sizeof(*pAlarms));
+	uint32_t ntics = kBench_AlarmTics / n;
+	tEvQ_Event ev;
+	uint32_t tic;
+	uint32_t i;
+
+	lat.capacity = ntics * n;
+	lat.pNs = calloc(lat.capacity, sizeof(lat.pNs[0]));
+	pRing = calloc(n, sizeof(*pRing));
+	if(pAlarms && lat.pNs && pRing)
+	{
+		pQueue = Cwsw_StubEvQ__Init(&queue, pRing, n);
+
+		lat.count = 0;
+		bench_alarms(pAlarms, n, true);
+		for(tic = 0; tic < ntics; ++tic)
+		{
+			passns = Cwsw_PerfCtr__NowNs();
+			(void)Cwsw_ClockSvc__Task();
+			for(i = 0; i < n; ++i)	{ Cwsw_SwAlarm__ManageTimer(&pAlarms[i]); }
+		}
+		report("Latency/callback", n);
+
+		lat.count = 0;
+		bench_alarms(pAlarms, n, false);
+		for(tic = 0; tic < ntics; ++tic)
+		{
+			passns = Cwsw_PerfCtr__NowNs();
+			(void)Cwsw_ClockSvc__Task();
+			for(i = 0; i < n; ++i)	{ Cwsw_SwAlarm__ManageTimer(&pAlarms[i]); }
+			while(Cwsw_StubEvQ__Get(&queue, &ev))	{ handlers[ev.evId](ev.evData); }
+		}
+		report("Latency/queue", n);
+	}
+
+	free(pRing);
+	free(lat.pNs);
+	free(pAlarms);
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+int
+main(void)
+{
+	uint32_t n;
+
+	for(n = 1; n <= kBench_Events; ++n)	{ handlers[n] = handler; }
+	Cwsw_ClockSvc__Init(NULL, 0);
+
+	for(n = 1; n <= 1000; n *= 10)	{ bench_latency(n); }
+	return 0;
+}
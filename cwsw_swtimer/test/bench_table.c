@@ -0,0 +1,161 @@
+/** @file
+ *	@brief	Benchmark: servicing a tic with an alarm table, against polling each alarm.
+ *
+ *	Prints one line of JSON per case (see Cwsw_PerfCtr__Format()); `param` is the number of alarms,
+ *	10, 1k and 100k, with periods spread over 1..1000 tics:
+ *	- `Tic/polled`: Cwsw_ClockSvc__Task() plus Cwsw_SwAlarm__ManageTimer() on each alarm.
+ *	- `Tic/table`: Cwsw_ClockSvc__Task() plus Cwsw_SwAlarmTable__Task() over the same alarms.
+ *	- `Scan/idle`: one Cwsw_SwAlarmTable__Scan() that finds nothing due; the floor of the table.
+ *
+ *	Events go to a stub queue that discards them. Runs on the simulated clock, so every run services
+ *	the same tics.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdio.h>
+#include <stdlib.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_clock.h"
+#include "cwsw_perfctr.h"
+#include "stub_evqueue.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_swtimer.h"
+#include "cwsw_alarmtable.h"
+
+#if (CWSW_CLOCK_BACKEND != CWSW_CLOCK_BACKEND_SIM)
+#error "The alarm table benchmark runs on the simulated clock."
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum {
+	kBench_AlarmTics	= 20000000,		//!< Alarm services per tic case (tics x alarms), at least.
+	kBench_MinTics		= 16,			//!< Fewest tics measured in a tic case.
+	kBench_MaxPeriod	= 1000			//!< Longest alarm period, in tics.
+};
+
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+static tCwswPerfCtr ctr;
+static tStubEvQ discard;
+static ptEvQ_QueueCtrlEx pDiscard;
+static volatile uint32_t sink;		//!< Keeps measured results alive.
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+static void
+report(const char *name, uint64_t param, const tCwswPerfSample *pSample)
+{
+	char line[256];
+
+	(void)Cwsw_PerfCtr__Format(line, sizeof(line), name, param, pSample);
+	puts(line);
+}
+
+/**	Set up `n` enabled periodic alarms, with periods spread over 1..kBench_MaxPeriod tics. */
+static void
+tic_alarms(ptCwswSwAlarm pAlarms, uint32_t n)
+{
+	tCwswClockTics period;
+	uint32_t i;
+
+	for(i = 0; i < n; ++i)
+	{
+		period = 1 + (tCwswClockTics)((i * 7919UL) % kBench_MaxPeriod);
+		(void)Cwsw_SwAlarm__Init(&pAlarms[i], 0, period, pDiscard, 1);
+		(void)Cwsw_ClockSvc__SetTimer(&pAlarms[i].tm, period);
+		Cwsw_SwAlarm__SetState(&pAlarms[i], kTmrState_Enabled);
+	}
+}
+
+static void
+bench_tic(uint32_t n)
+{
+	tCwswSwAlarmTable tbl;
+	tCwswPerfSample sample;
+	ptCwswSwAlarm pAlarms = calloc(n, sizeof(*pAlarms));
+	tCwswClockTics *pDeadlines = calloc(n, sizeof(*pDeadlines));
+	uint32_t *pEnabled = calloc(CWSW_ALARMTABLE_WORDS(n), sizeof(*pEnabled));
+	uint32_t *pMatured = calloc(CWSW_ALARMTABLE_WORDS(n), sizeof(*pMatured));
+	uint32_t ntics = kBench_AlarmTics / n;
+	uint32_t tic;
+	uint32_t i;
+
+	if(pAlarms && pDeadlines && pEnabled && pMatured)
+	{
+		if(ntics < kBench_MinTics)	{ ntics = kBench_MinTics; }
+
+		tic_alarms(pAlarms, n);
+		Cwsw_PerfCtr__Start(&ctr);
+		for(tic = 0; tic < ntics; ++tic)
+		{
+			(void)Cwsw_ClockSvc__Task();
+			for(i = 0; i < n; ++i)	{ Cwsw_SwAlarm__ManageTimer(&pAlarms[i]); }
+		}
+		Cwsw_PerfCtr__Stop(&ctr, &sample, ntics);
+		report("Tic/polled", n, &sample);
+
+		tic_alarms(pAlarms, n);
+		(void)Cwsw_SwAlarmTable__Init(&tbl, pDeadlines, pEnabled, pMatured, pAlarms, n);
+		Cwsw_PerfCtr__Start(&ctr);
+		for(tic = 0; tic < ntics; ++tic)
+		{
+			(void)Cwsw_ClockSvc__Task();
+			sink = Cwsw_SwAlarmTable__Task(&tbl);
+		}
+		Cwsw_PerfCtr__Stop(&ctr, &sample, ntics);
+		report("Tic/table", n, &sample);
+
+		// every alarm is at least one tic away once the table has been serviced.
+		Cwsw_PerfCtr__Start(&ctr);
+		for(tic = 0; tic < ntics; ++tic)	{ sink = Cwsw_SwAlarmTable__Scan(&tbl, tbl.scantm); }
+		Cwsw_PerfCtr__Stop(&ctr, &sample, ntics);
+		report("Scan/idle", n, &sample);
+	}
+
+	free(pMatured);
+	free(pEnabled);
+	free(pDeadlines);
+	free(pAlarms);
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+int
+main(void)
+{
+	uint32_t n;
+
+	pDiscard = Cwsw_StubEvQ__Init(&discard, NULL, 0);
+	Cwsw_ClockSvc__Init(NULL, 0);
+	(void)Cwsw_PerfCtr__Open(&ctr);
+
+	for(n = 10; n <= 100000; n *= 100)	{ bench_tic(n); }
+
+	Cwsw_PerfCtr__Close(&ctr);
+	return 0;
+}
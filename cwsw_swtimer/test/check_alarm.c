@@ -0,0 +1,217 @@
+/** @file
+ *	@brief	Check: catch-up callbacks of a periodic alarm serviced late, and what stops them.
+ *
+ *	An alarm with the kSwAlarmRearm_PostEach policy, serviced several periods late, calls its callback
+ *	once for each period, with each period's deadline. A callback that disables, pauses or re-arms the
+ *	alarm gets no more calls after that one, and what it did sticks.
+ *
+ *	Also checks alarm group membership: an alarm joins at most one group, once.
+ *
+ *	Runs on the simulated clock. Prints one line of JSON and exits nonzero on any mismatch.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdio.h>
+#include <stdbool.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_clock.h"
+#include "stub_evqueue.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_swtimer.h"
+#include "cwsw_alarmsched.h"
+
+#if (CWSW_CLOCK_BACKEND != CWSW_CLOCK_BACKEND_SIM)
+#error "The alarm check runs on the simulated clock."
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum {
+	kCheck_Period	= 10,			//!< Period of the alarm, in tics.
+	kCheck_Late		= 13,			//!< Whole periods the alarm is serviced late.
+	kCheck_Start	= 1000,			//!< Tic the alarm is serviced on.
+	kCheck_Rearm	= 500			//!< Duration a callback re-arms the alarm with.
+};
+
+/**	What the callback does, and on which call. */
+enum eCheckAction {
+	kCheckAction_None,
+	kCheckAction_Disable,
+	kCheckAction_Pause,
+	kCheckAction_Rearm
+};
+
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+static tCwswSwAlarm alarm;
+static enum eCheckAction action;
+static uint32_t actoncall;		//!< Call on which the callback acts; 1 for the first.
+static uint32_t ncalls;
+static bool inorder;			//!< Each call's data was the previous call's deadline plus one period.
+static uint32_t lastdata;
+
+static uint64_t ncases;
+static uint64_t nfaults;
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/**	Count a check's expectation, and say which failed. */
+static void
+check_that(bool ok, const char *name, const char *what)
+{
+	if(ok)	{ return; }
+	fprintf(stderr, "check_alarm: %s: %s\n", name, what);
+	++nfaults;
+}
+
+static void
+cb_matured(struct sSwTimer *pAlarm, uint32_t evdata, void *pCtx)
+{
+	(void)pCtx;
+	if(ncalls && (evdata != lastdata + kCheck_Period))	{ inorder = false; }
+	lastdata = evdata;
+	if(++ncalls != actoncall)	{ return; }
+
+	switch(action)
+	{
+	case kCheckAction_Disable:
+		Cwsw_SwAlarm__SetState(pAlarm, kTmrState_Disabled);
+		break;
+	case kCheckAction_Pause:
+		Cwsw_SwAlarm__Pause(pAlarm);
+		break;
+	case kCheckAction_Rearm:
+		(void)Cwsw_ClockSvc__SetTimer(&pAlarm->tm, kCheck_Rearm);
+		break;
+	case kCheckAction_None:
+	default:
+		break;
+	}
+}
+
+/**	Service the alarm kCheck_Late periods after its deadline, with the callback acting on call `on`.
+ *	@returns The alarm's deadline before it was serviced.
+ */
+static tCwswClockTics
+run(enum eCheckAction act, uint32_t on)
+{
+	tCwswClockTics deadline = Cwsw_TicsAfter(Cwsw_ClockSvc__TimerTic(), -(kCheck_Late * kCheck_Period));
+
+	++ncases;
+	(void)Cwsw_SwAlarm__Init(&alarm, 0, kCheck_Period, NULL, 1);
+	Cwsw_SwAlarm__SetRearmPolicy(&alarm, kSwAlarmRearm_PostEach);
+	Cwsw_SwAlarm__SetCallback(&alarm, cb_matured, NULL);
+	alarm.tm = deadline;
+	Cwsw_SwAlarm__SetState(&alarm, kTmrState_Enabled);
+
+	action = act;
+	actoncall = on;
+	ncalls = 0;
+	inorder = true;
+	Cwsw_SwAlarm__ManageTimer(&alarm);
+	return deadline;
+}
+
+/**	Group membership: adding an alarm twice, or to a second group, is refused and leaves both
+ *	groups intact.
+ */
+static void
+check_group(void)
+{
+	const char *name = "group";
+	tCwswSwAlarmSched sched;
+	tCwswSwAlarmGroup group1;
+	tCwswSwAlarmGroup group2;
+	tCwswSwAlarm a;
+	tCwswSwAlarm b;
+
+	++ncases;
+	(void)Cwsw_SwAlarmSched__Init(&sched);
+	Cwsw_SwAlarmSched__GroupInit(&group1);
+	Cwsw_SwAlarmSched__GroupInit(&group2);
+	(void)Cwsw_SwAlarm__Init(&a, 0, 0, NULL, 0);
+	(void)Cwsw_SwAlarm__Init(&b, 0, 0, NULL, 0);
+	(void)Cwsw_SwAlarmSched__Arm(&sched, &a, 100);
+	(void)Cwsw_SwAlarmSched__Arm(&sched, &b, 100);
+
+	check_that(!Cwsw_SwAlarmSched__GroupAdd(&group1, &a), name, "first add refused");
+	check_that(!Cwsw_SwAlarmSched__GroupAdd(&group1, &b), name, "second member refused");
+	check_that(Cwsw_SwAlarmSched__GroupAdd(&group1, &a) == kErr_SwTmr_BadParm, name, "added twice");
+	check_that(Cwsw_SwAlarmSched__GroupAdd(&group2, &b) == kErr_SwTmr_BadParm, name, "added to a second group");
+	check_that(Cwsw_SwAlarmSched__PauseGroup(&sched, &group1) == 2, name, "group not paused whole");
+	check_that(Cwsw_SwAlarmSched__PauseGroup(&sched, &group2) == 0, name, "other group not empty");
+	check_that(Cwsw_SwAlarmSched__ResumeGroup(&sched, &group1) == 2, name, "group not resumed whole");
+
+	Cwsw_SwAlarmSched__GroupRemove(&group2, &b);		// not a member; no effect
+	Cwsw_SwAlarmSched__GroupRemove(&group1, &b);
+	check_that(!Cwsw_SwAlarmSched__GroupAdd(&group2, &b), name, "removed alarm can't join another group");
+	check_that(Cwsw_SwAlarmSched__PauseGroup(&sched, &group1) == 1, name, "removed alarm still in its old group");
+	check_that(Cwsw_SwAlarmSched__PauseGroup(&sched, &group2) == 1, name, "alarm not in its new group");
+
+	Cwsw_SwAlarmSched__Cancel(&sched, &a);
+	Cwsw_SwAlarmSched__Cancel(&sched, &b);
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+int
+main(void)
+{
+	tCwswClockTics deadline;
+	tCwswClockTics now;
+
+	Cwsw_ClockSvc__Init(NULL, 0);
+	while(Cwsw_ClockSvc__Task() < kCheck_Start)	{ }
+	now = Cwsw_ClockSvc__TimerTic();
+
+	deadline = run(kCheckAction_None, 0);
+	check_that(ncalls == kCheck_Late + 1, "catch up", "not one call per period");
+	check_that(inorder, "catch up", "periods out of order");
+	check_that(lastdata == (uint32_t)(deadline + (kCheck_Late * kCheck_Period)), "catch up", "last period's data wrong");
+	check_that(alarm.tm == Cwsw_TicsAfter(deadline, (kCheck_Late + 1) * kCheck_Period), "catch up", "not rearmed on the next period");
+
+	(void)run(kCheckAction_Disable, 1);
+	check_that(ncalls == 1, "disable", "called after disabling");
+	check_that(alarm.tmrstate == kTmrState_Disabled, "disable", "not disabled");
+
+	deadline = run(kCheckAction_Pause, 2);
+	check_that(ncalls == 2, "pause", "called after pausing");
+	check_that(alarm.tmrstate == kTmrState_Paused, "pause", "not paused");
+	check_that(alarm.tm == Cwsw_ElapsedTimeMs(now, Cwsw_TicsAfter(deadline, (kCheck_Late + 1) * kCheck_Period)),
+		"pause", "time left not frozen");
+
+	(void)run(kCheckAction_Rearm, 3);
+	check_that(ncalls == 3, "rearm", "called after re-arming");
+	check_that(alarm.tmrstate == kTmrState_Enabled, "rearm", "not enabled");
+	check_that(alarm.tm == Cwsw_TicsAfter(now, kCheck_Rearm), "rearm", "re-armed deadline lost");
+
+	check_group();
+
+	printf("{\"check\":\"alarm\",\"cases\":%llu,\"faults\":%llu}\n",
+		(unsigned long long)ncases, (unsigned long long)nfaults);
+	return nfaults ? 1 : 0;
+}
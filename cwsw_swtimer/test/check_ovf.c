@@ -0,0 +1,207 @@
+/** @file
+ *	@brief	Check: delivery of alarm events to a full queue, through an overflow buffer.
+ *
+ *	For each overflow policy, delivers more events than a stub queue and its buffer can take, then
+ *	makes room for one event and delivers one more, which must wait behind the events still held.
+ *	Checks which deliveries report a lost event, the buffer's counters, and the order the consumer
+ *	sees the events in once Cwsw_SwAlarmOvf__RetryAll() has posted everything held. Also checks the
+ *	counters of queues without a buffer.
+ *
+ *	Prints one line of JSON and exits nonzero on any mismatch.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdio.h>
+#include <stdbool.h>
+
+// ----	Project Headers -------------------------
+#include "stub_evqueue.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_swtimer.h"
+#include "cwsw_alarmovf.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum {
+	kCheck_Ring		= 2,		//!< Events the stub queue takes.
+	kCheck_Held		= 3,		//!< Events the overflow buffer holds.
+	kCheck_Events	= 8			//!< Most events a case delivers, or sees.
+};
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/**	One policy's case: what is delivered, and what must come of it. */
+typedef struct sCheckOvfCase {
+	const char				*name;
+	tSwAlarmOvfPolicy		policy;
+	tEvQ_Event				sent[kCheck_Events];	/**< Delivered while the queue is full. */
+	uint32_t				nsent;
+	tEvQ_Event				late;		/**< Delivered once the consumer has taken one event. */
+	uint32_t				nlost;		/**< Deliveries that must report the event lost. */
+	tCwswSwAlarmOvfStats	stats;		/**< Buffer's counters at the end. */
+	tEvQ_Event				order[kCheck_Events];	/**< Events as the consumer must see them. */
+	uint32_t				norder;
+} tCheckOvfCase;
+
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+static const tCheckOvfCase cases[] = {
+	{	// the buffer fills, and the last event is lost.
+		.name = "drop newest", .policy = kSwAlarmOvf_DropNewest,
+		.sent = { {1, 1}, {1, 2}, {1, 3}, {1, 4}, {1, 5}, {1, 6} }, .nsent = 6,
+		.late = {1, 7}, .nlost = 1,
+		.stats = { .deferred = 4, .retried = 4, .coalesced = 0, .dropped = 1, .maxdepth = 3 },
+		.order = { {1, 1}, {1, 2}, {1, 3}, {1, 4}, {1, 5}, {1, 7} }, .norder = 6
+	},
+	{	// events with an ID already held update it in place; a new ID finds the buffer full.
+		.name = "coalesce", .policy = kSwAlarmOvf_Coalesce,
+		.sent = { {1, 1}, {2, 2}, {1, 3}, {2, 4}, {1, 5}, {3, 6}, {3, 7}, {4, 8} }, .nsent = 8,
+		.late = {5, 9}, .nlost = 1,
+		.stats = { .deferred = 4, .retried = 4, .coalesced = 2, .dropped = 1, .maxdepth = 3 },
+		.order = { {1, 1}, {2, 2}, {1, 5}, {2, 4}, {3, 7}, {5, 9} }, .norder = 6
+	},
+	{	// the oldest event held makes way for the newest.
+		.name = "overwrite oldest", .policy = kSwAlarmOvf_OverwriteOldest,
+		.sent = { {1, 1}, {1, 2}, {1, 3}, {1, 4}, {1, 5}, {1, 6} }, .nsent = 6,
+		.late = {1, 7}, .nlost = 0,
+		.stats = { .deferred = 5, .retried = 4, .coalesced = 0, .dropped = 1, .maxdepth = 3 },
+		.order = { {1, 1}, {1, 2}, {1, 4}, {1, 5}, {1, 6}, {1, 7} }, .norder = 6
+	},
+};
+
+static tStubEvQ stubs[sizeof(cases) / sizeof(cases[0])];
+static tEvQ_Event rings[sizeof(cases) / sizeof(cases[0])][kCheck_Ring];
+static tCwswSwAlarmOverflow ovfs[sizeof(cases) / sizeof(cases[0])];
+static tEvQ_Event held[sizeof(cases) / sizeof(cases[0])][kCheck_Held];
+
+static uint64_t ncases;
+static uint64_t nfaults;
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/**	Count a check's expectation, and say which failed. */
+static void
+check_that(bool ok, const char *name, const char *what)
+{
+	if(ok)	{ return; }
+	fprintf(stderr, "check_ovf: %s: %s\n", name, what);
+	++nfaults;
+}
+
+static bool
+same_event(tEvQ_Event a, tEvQ_Event b)
+{
+	return (a.evId == b.evId) && (a.evData == b.evData);
+}
+
+/**	Run one policy's case on its own queue and buffer. */
+static void
+check_policy(uint32_t c)
+{
+	const tCheckOvfCase *pCase = &cases[c];
+	ptEvQ_QueueCtrlEx pEvQX = Cwsw_StubEvQ__Init(&stubs[c], rings[c], kCheck_Ring);
+	tEvQ_Event seen[kCheck_Events];
+	tCwswSwAlarmOvfStats stats;
+	uint32_t nseen = 0;
+	uint32_t nlost = 0;
+	uint32_t idx;
+	bool inorder;
+
+	++ncases;
+	check_that(!Cwsw_SwAlarmOvf__Attach(&ovfs[c], pEvQX, held[c], kCheck_Held, pCase->policy), pCase->name, "attach refused");
+	check_that(Cwsw_SwAlarmOvf__Attach(&ovfs[c], pEvQX, held[c], kCheck_Held, pCase->policy) == kErr_SwTmr_BadParm,
+		pCase->name, "second buffer attached");
+
+	for(idx = 0; idx < pCase->nsent; ++idx)
+	{
+		if(Cwsw_SwAlarm__Deliver(pEvQX, pCase->sent[idx]))	{ ++nlost; }
+	}
+	check_that(nlost == pCase->nlost, pCase->name, "wrong number of events reported lost");
+	check_that(Cwsw_SwAlarmOvf__Depth(&ovfs[c]) == kCheck_Held, pCase->name, "buffer not full");
+
+	// room for one: the oldest event held takes it, and the late event waits behind the rest.
+	(void)Cwsw_StubEvQ__Get(&stubs[c], &seen[nseen++]);
+	check_that(!Cwsw_SwAlarm__Deliver(pEvQX, pCase->late), pCase->name, "late event lost");
+
+	// the consumer takes what it can each tic, and the held events are retried.
+	do {
+		while((nseen < kCheck_Events) && Cwsw_StubEvQ__Get(&stubs[c], &seen[nseen]))	{ ++nseen; }
+		Cwsw_SwAlarmOvf__RetryAll();
+	} while(stubs[c].count);
+	check_that(!Cwsw_SwAlarmOvf__Depth(&ovfs[c]), pCase->name, "events still held");
+
+	inorder = (nseen == pCase->norder);
+	for(idx = 0; inorder && (idx < nseen); ++idx)	{ inorder = same_event(seen[idx], pCase->order[idx]); }
+	check_that(inorder, pCase->name, "events out of order, or missing");
+
+	Cwsw_SwAlarmOvf__GetStats(&ovfs[c], &stats, true);
+	check_that(stats.deferred == pCase->stats.deferred, pCase->name, "deferred");
+	check_that(stats.retried == pCase->stats.retried, pCase->name, "retried");
+	check_that(stats.coalesced == pCase->stats.coalesced, pCase->name, "coalesced");
+	check_that(stats.dropped == pCase->stats.dropped, pCase->name, "dropped");
+	check_that(stats.maxdepth == pCase->stats.maxdepth, pCase->name, "maxdepth");
+
+	Cwsw_SwAlarmOvf__GetStats(&ovfs[c], &stats, false);
+	check_that(!stats.deferred && !stats.retried && !stats.coalesced && !stats.dropped && !stats.maxdepth,
+		pCase->name, "counters not reset");
+}
+
+/**	A queue without a buffer loses what it can't take, and counts it with the others like it. */
+static void
+check_unbuffered(void)
+{
+	const char *name = "no buffer";
+	static tStubEvQ stub;
+	static tEvQ_Event ring[1];
+	ptEvQ_QueueCtrlEx pEvQX = Cwsw_StubEvQ__Init(&stub, ring, 1);
+	tCwswSwAlarmOvfStats stats;
+
+	++ncases;
+	Cwsw_SwAlarmOvf__GetStats(NULL, &stats, true);
+	check_that(!Cwsw_SwAlarm__Deliver(pEvQX, (tEvQ_Event){1, 1}), name, "first event lost");
+	check_that(Cwsw_SwAlarm__Deliver(pEvQX, (tEvQ_Event){1, 2}) == kErr_EvQ_QueueFull, name, "second event not lost");
+
+	Cwsw_SwAlarmOvf__GetStats(NULL, &stats, false);
+	check_that((stats.dropped == 1) && !stats.deferred && !stats.retried, name, "counters");
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+int
+main(void)
+{
+	uint32_t c;
+
+	for(c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c)	{ check_policy(c); }
+	check_unbuffered();
+
+	printf("{\"check\":\"ovf\",\"cases\":%llu,\"faults\":%llu}\n",
+		(unsigned long long)ncases, (unsigned long long)nfaults);
+	return nfaults ? 1 : 0;
+}
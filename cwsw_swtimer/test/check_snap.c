@@ -0,0 +1,291 @@
+/** @file
+ *	@brief	Check: save and restore SW alarms through a snapshot, and reject damaged snapshots.
+ *
+ *	Saves a set of alarms (enabled, overdue, paused and disabled; bound to either of two queues or to
+ *	none), restarts the clock, and restores them: each alarm gets back its reload, slack, event
+ *	binding, rearm policy and state, enabled alarms their time left after the current tic, and the
+ *	clock its tics since initialization. Then restores from snapshots that are truncated, that have a
+ *	flipped checksum or record byte, or that name a queue missing from the set, and checks that each
+ *	is refused without touching any alarm.
+ *
+ *	Runs on the simulated clock, and writes its snapshots to the current directory. Prints one line
+ *	of JSON and exits nonzero on any mismatch.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_clock.h"
+#include "stub_evqueue.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_swtimer.h"
+#include "cwsw_alarmsnap.h"
+
+#if (CWSW_CLOCK_BACKEND != CWSW_CLOCK_BACKEND_SIM)
+#error "The snapshot check runs on the simulated clock."
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum {
+	kCheck_Alarms		= 4,
+	kCheck_Queues		= 2,
+	kCheck_SaveTic		= 1000,		//!< Tic the snapshot is saved on.
+	kCheck_Down			= 37,		//!< Tics the restarted clock runs before the restore.
+	kCheck_MaxImage		= 1024,		//!< Largest snapshot image the check handles.
+	kCheck_ChecksumAt	= 12		//!< Offset of the header's checksum, in the version 1 layout.
+};
+
+static const char snappath[] = "check_snap.bin";
+static const char badpath[] = "check_snap_bad.bin";
+
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+static tCwswSwAlarm alarms[kCheck_Alarms];
+static tCwswSwAlarm saved[kCheck_Alarms];		//!< The alarms as they were saved.
+static tStubEvQ stubs[kCheck_Queues];
+static ptEvQ_QueueCtrlEx queues[kCheck_Queues];
+static tCwswSwAlarmSnapSet set;
+
+static uint8_t image[kCheck_MaxImage];			//!< The good snapshot, as saved.
+static size_t imagesize;
+
+static uint64_t ncases;
+static uint64_t nfaults;
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/**	Count a check's expectation, and say which failed. */
+static void
+check_that(bool ok, const char *name, const char *what)
+{
+	if(ok)	{ return; }
+	fprintf(stderr, "check_snap: %s: %s\n", name, what);
+	++nfaults;
+}
+
+/**	Read a whole file into `pBuf`.
+ *	@returns Bytes read; 0 if the file can't be read, or doesn't fit.
+ */
+static size_t
+file_read(const char *path, uint8_t *pBuf, size_t cap)
+{
+	FILE *pFile = fopen(path, "rb");
+	size_t size;
+
+	if(!pFile)	{ return 0; }
+	size = fread(pBuf, 1, cap, pFile);
+	if(!feof(pFile))	{ size = 0; }
+	(void)fclose(pFile);
+	return size;
+}
+
+static bool
+file_write(const char *path, const uint8_t *pBuf, size_t size)
+{
+	FILE *pFile = fopen(path, "wb");
+	bool ok;
+
+	if(!pFile)	{ return false; }
+	ok = (fwrite(pBuf, 1, size, pFile) == size);
+	return (fclose(pFile) == 0) && ok;
+}
+
+/**	Set up the alarms: one due later, one overdue, one paused and one disabled, over both queues
+ *	and none.
+ */
+static void
+snap_alarms(void)
+{
+	(void)Cwsw_SwAlarm__Init(&alarms[0], 0, 50, queues[0], 1);
+	Cwsw_SwAlarm__SetRearmPolicy(&alarms[0], kSwAlarmRearm_PostEach);
+	Cwsw_SwAlarm__SetSlack(&alarms[0], 3);
+	(void)Cwsw_ClockSvc__SetTimer(&alarms[0].tm, 100);
+	Cwsw_SwAlarm__SetState(&alarms[0], kTmrState_Enabled);
+
+	(void)Cwsw_SwAlarm__Init(&alarms[1], 0, 0, queues[1], 2);
+	alarms[1].tm = Cwsw_TicsAfter(Cwsw_ClockSvc__TimerTic(), -5);
+	Cwsw_SwAlarm__SetState(&alarms[1], kTmrState_Enabled);
+
+	(void)Cwsw_SwAlarm__Init(&alarms[2], 0, 20, queues[1], 3);
+	(void)Cwsw_ClockSvc__SetTimer(&alarms[2].tm, 30);
+	Cwsw_SwAlarm__SetState(&alarms[2], kTmrState_Enabled);
+	Cwsw_SwAlarm__Pause(&alarms[2]);
+
+	(void)Cwsw_SwAlarm__Init(&alarms[3], 0, 0, NULL, 0);
+}
+
+/**	Restart: lose the alarms, and start the clock over, running it kCheck_Down tics. */
+static void
+snap_restart(void)
+{
+	uint32_t idx;
+
+	for(idx = 0; idx < kCheck_Alarms; ++idx)	{ (void)Cwsw_SwAlarm__Init(&alarms[idx], 0, 0, NULL, 0); }
+	Cwsw_ClockSvc__Init(NULL, 0);
+	for(idx = 0; idx < kCheck_Down; ++idx)		{ (void)Cwsw_ClockSvc__Task(); }
+}
+
+/**	Save, restart and restore; compare each alarm with what was saved. */
+static void
+check_roundtrip(void)
+{
+	const char *name = "roundtrip";
+	tCwswClockSnapshot atsave;
+	tCwswClockSnapshot before;
+	tCwswClockSnapshot after;
+	tCwswClockTics savetic;
+	tCwswClockTics now;
+	tCwswClockTics left;
+	uint32_t idx;
+
+	++ncases;
+	snap_alarms();
+	memcpy(saved, alarms, sizeof(saved));
+	savetic = Cwsw_ClockSvc__TimerTic();
+	Cwsw_ClockSvc__GetSnapshot(&atsave);
+	check_that(Cwsw_SwAlarmSnap__Save(snappath, &set) == kErr_SwTmr_NoError, name, "save failed");
+	check_that(access("check_snap.bin.tmp", F_OK) != 0, name, "temporary file left behind");
+	imagesize = file_read(snappath, image, sizeof(image));
+	check_that(imagesize != 0, name, "snapshot unreadable");
+
+	snap_restart();
+	now = Cwsw_ClockSvc__TimerTic();
+	Cwsw_ClockSvc__GetSnapshot(&before);
+	check_that(Cwsw_SwAlarmSnap__Restore(snappath, &set) == kErr_SwTmr_NoError, name, "restore failed");
+	Cwsw_ClockSvc__GetSnapshot(&after);
+	check_that(after.sinceinit == before.sinceinit + atsave.sinceinit, "rebase", "tics since init not carried on");
+	check_that(after.tic == before.tic, "rebase", "raw tic moved");
+
+	for(idx = 0; idx < kCheck_Alarms; ++idx)
+	{
+		check_that(alarms[idx].tmrstate == saved[idx].tmrstate, name, "state");
+		check_that(alarms[idx].reloadtm == saved[idx].reloadtm, name, "reload");
+		check_that(alarms[idx].slack == saved[idx].slack, name, "slack");
+		check_that(alarms[idx].evid == saved[idx].evid, name, "event");
+		check_that(alarms[idx].pEvQX == saved[idx].pEvQX, name, "queue");
+		check_that(alarms[idx].rearm == saved[idx].rearm, name, "rearm policy");
+		if(saved[idx].tmrstate == kTmrState_Enabled)
+		{
+			// time down doesn't count: the deadline is the time left after the current tic.
+			left = Cwsw_ElapsedTimeMs(savetic, saved[idx].tm);
+			check_that(alarms[idx].tm == Cwsw_TicsAfter(now, left), "rebase", "deadline not carried over");
+		}
+		else
+		{
+			check_that(alarms[idx].tm == saved[idx].tm, name, "time left");
+		}
+	}
+}
+
+/**	Restore from a damaged image; it must be refused with `rc`, leaving the alarms as they were. */
+static void
+check_refused(const char *name, const uint8_t *pImage, size_t size, const tCwswSwAlarmSnapSet *pSet,
+	tErrorCodes_SwTmr rc)
+{
+	tCwswSwAlarm before[kCheck_Alarms];
+	tCwswClockSnapshot clkbefore;
+	tCwswClockSnapshot clkafter;
+
+	++ncases;
+	memcpy(before, alarms, sizeof(before));
+	Cwsw_ClockSvc__GetSnapshot(&clkbefore);
+	if(pImage && !file_write(badpath, pImage, size))
+	{
+		check_that(false, name, "can't write the damaged snapshot");
+		return;
+	}
+	check_that(Cwsw_SwAlarmSnap__Restore(pImage ? badpath : "check_snap_none.bin", pSet) == rc, name, "not refused");
+	Cwsw_ClockSvc__GetSnapshot(&clkafter);
+	check_that(!memcmp(before, alarms, sizeof(before)), name, "alarms touched");
+	check_that(clkafter.sinceinit == clkbefore.sinceinit, name, "clock rebased");
+}
+
+/**	Snapshots that must be refused. */
+static void
+check_damaged(void)
+{
+	uint8_t bad[kCheck_MaxImage];
+	tCwswSwAlarmSnapSet fewer = set;
+	tCwswSwAlarmSnapSet unlisted = set;
+
+	check_refused("truncated", image, imagesize - 1, &set, kErr_SwTmr_BadSnapshot);
+	check_refused("header only", image, kCheck_ChecksumAt, &set, kErr_SwTmr_BadSnapshot);
+
+	memcpy(bad, image, imagesize);
+	bad[kCheck_ChecksumAt] ^= 0x01;
+	check_refused("checksum", bad, imagesize, &set, kErr_SwTmr_BadSnapshot);
+
+	memcpy(bad, image, imagesize);
+	bad[imagesize - 1] ^= 0x80;
+	check_refused("record", bad, imagesize, &set, kErr_SwTmr_BadSnapshot);
+
+	// alarms 1 and 2 were saved bound to the second queue, which this set doesn't have.
+	fewer.nqueues = 1;
+	check_refused("queue index", image, imagesize, &fewer, kErr_SwTmr_BadSnapshot);
+
+	--fewer.nalarms;
+	fewer.nqueues = kCheck_Queues;
+	check_refused("alarm count", image, imagesize, &fewer, kErr_SwTmr_BadSnapshot);
+
+	check_refused("missing", NULL, 0, &set, kErr_SwTmr_Io);
+
+	// a queue missing from the table can't be saved either, and the good snapshot stays.
+	++ncases;
+	unlisted.nqueues = 1;
+	check_that(Cwsw_SwAlarmSnap__Save(snappath, &unlisted) == kErr_SwTmr_BadParm, "unlisted queue", "saved");
+	check_that((file_read(snappath, bad, sizeof(bad)) == imagesize) && !memcmp(bad, image, imagesize),
+		"unlisted queue", "good snapshot replaced");
+
+	(void)unlink(badpath);
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+int
+main(void)
+{
+	uint32_t idx;
+
+	for(idx = 0; idx < kCheck_Queues; ++idx)	{ queues[idx] = Cwsw_StubEvQ__Init(&stubs[idx], NULL, 0); }
+	set = (tCwswSwAlarmSnapSet){ .pAlarms = alarms, .nalarms = kCheck_Alarms, .pQueues = queues,
+		.nqueues = kCheck_Queues, .pSched = NULL };
+
+	Cwsw_ClockSvc__Init(NULL, 0);
+	while(Cwsw_ClockSvc__Task() < kCheck_SaveTic)	{ }
+
+	check_roundtrip();
+	check_damaged();
+	(void)unlink(snappath);
+
+	printf("{\"check\":\"snap\",\"cases\":%llu,\"faults\":%llu}\n",
+		(unsigned long long)ncases, (unsigned long long)nfaults);
+	return nfaults ? 1 : 0;
+}
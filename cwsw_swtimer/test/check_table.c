@@ -0,0 +1,376 @@
+/** @file
+ *	@brief	Check: the alarm table's expiry scan agrees with a plain reference, whichever scan is built.
+ *
+ *	Cwsw_SwAlarmTable__Scan() tests deadlines with SSE2 or AVX2 where the compiler targets them, and
+ *	with a scalar loop otherwise (or when CWSW_ALARMTABLE_SIMD is 0); the makefile builds this check
+ *	once for each. Every scan's matured bitset and count are compared with a one-alarm-at-a-time
+ *	reference, over:
+ *	- random deadlines and enable bits, at random points in time;
+ *	- deadlines on either side of `now` by 0, 1 and half the range of the clock, with `now` close to
+ *	  either end of the range, so the subtraction wraps;
+ *	- table sizes that leave the last bitset word partly used.
+ *
+ *	Then, on the simulated clock, checks that dispatch honors what alarms' callbacks do to other
+ *	alarms due on the same tic: an alarm disabled by an earlier callback of the same pass doesn't
+ *	mature, and one re-armed matures at its new deadline, not at the old one. And that an alarm
+ *	paused from a callback, its own or another's, keeps the time it had left, and matures that long
+ *	after it is resumed.
+ *
+ *	Prints one line of JSON and exits nonzero on any mismatch. An AVX2 build exits 0, with
+ *	`"skipped":true`, on a CPU without AVX2.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_clock.h"
+#include "stub_evqueue.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_swtimer.h"
+#include "cwsw_alarmtable.h"
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum {
+	kCheck_MaxAlarms	= 300,		//!< Largest table checked.
+	kCheck_Rounds		= 2000,		//!< Random scans per table size.
+	kCheck_CbAlarms		= 4,		//!< Alarms in the dispatch checks, all due on the same tic.
+	kCheck_CbDue		= 5,		//!< Tics until they are due.
+	kCheck_CbRearm		= 50,		//!< Duration an alarm is re-armed with, from a callback.
+	kCheck_CbPeriod		= 20,		//!< Period of the alarms in the pause checks.
+	kCheck_CbPausedFor	= 7,		//!< Tics an alarm stays paused.
+	kCheck_MaxTics		= 1000		//!< Most tics to wait for an alarm.
+};
+
+#if (CWSW_ALARMTABLE_SIMD) && defined(__AVX2__)
+#define CHECK_SCAN	"avx2"
+#elif (CWSW_ALARMTABLE_SIMD) && defined(__SSE2__)
+#define CHECK_SCAN	"sse2"
+#else
+#define CHECK_SCAN	"scalar"
+#endif
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/**	What an alarm's callback does the first time it runs, in a dispatch check. */
+typedef void (*pfCheckAction)(void);
+
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+static tCwswSwAlarm alarms[kCheck_MaxAlarms];
+static tCwswClockTics deadlines[kCheck_MaxAlarms];
+static uint32_t enabled[CWSW_ALARMTABLE_WORDS(kCheck_MaxAlarms)];
+static uint32_t matured[CWSW_ALARMTABLE_WORDS(kCheck_MaxAlarms)];
+static tCwswSwAlarmTable tbl;
+static tStubEvQ discard;
+static ptEvQ_QueueCtrlEx pDiscard;
+
+static tCwswSwAlarm cbalarms[kCheck_CbAlarms];
+static tCwswClockTics cbdeadlines[kCheck_CbAlarms];
+static uint32_t cbenabled[CWSW_ALARMTABLE_WORDS(kCheck_CbAlarms)];
+static uint32_t cbmatured[CWSW_ALARMTABLE_WORDS(kCheck_CbAlarms)];
+static tCwswSwAlarmTable cbtbl;
+static uint32_t cbcalls[kCheck_CbAlarms];		//!< Callbacks run, per alarm.
+static pfCheckAction cbactions[kCheck_CbAlarms];
+
+static uint64_t rng = 0x9E3779B97F4A7C15ULL;
+static uint64_t nscans;
+static uint64_t ncases;
+static uint64_t nfaults;
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/**	xorshift64; the same sequence on every run. */
+static uint64_t
+rand64(void)
+{
+	rng ^= rng << 13;
+	rng ^= rng >> 7;
+	rng ^= rng << 17;
+	return rng;
+}
+
+/**	Pick a point in time: anywhere, or close to one end of the clock's range. */
+static tCwswClockTics
+pick_now(void)
+{
+	static const uint64_t edges[] = { 0, 0x7FFFFFFFFFFFFFFFULL, 0x8000000000000000ULL, 0xFFFFFFFFFFFFFFFFULL };
+	uint64_t r = rand64();
+
+	if(r & 1)	{ return (tCwswClockTics)rand64(); }
+	return (tCwswClockTics)(edges[(r >> 1) % 4] + ((r >> 8) % 5) - 2);
+}
+
+/**	Pick a deadline: anywhere, or at one of the edges of being due relative to `now`. */
+static tCwswClockTics
+pick_deadline(tCwswClockTics now)
+{
+	static const uint64_t offsets[] = {
+		0, 1, (uint64_t)-1, 2, (uint64_t)-2,
+		0x7FFFFFFFFFFFFFFFULL, 0x8000000000000000ULL, 0x8000000000000001ULL
+	};
+	uint64_t r = rand64();
+
+	if(r & 1)	{ return (tCwswClockTics)rand64(); }
+	return (tCwswClockTics)((uint64_t)now + offsets[(r >> 1) % (sizeof(offsets) / sizeof(offsets[0]))]);
+}
+
+/**	Scan the table at `now`, and compare with the reference. */
+static void
+check_scan(uint32_t n, tCwswClockTics now)
+{
+	uint32_t expect[CWSW_ALARMTABLE_WORDS(kCheck_MaxAlarms)] = { 0 };
+	uint32_t nexpect = 0;
+	uint32_t got;
+	uint32_t idx;
+
+	for(idx = 0; idx < n; ++idx)
+	{
+		// due once (now - deadline), taken modulo 2^64, is non-negative as a signed value.
+		if((alarms[idx].tmrstate == kTmrState_Enabled) && ((int64_t)((uint64_t)now - (uint64_t)deadlines[idx]) >= 0))
+		{
+			expect[idx / kSwAlarmTable_BitsPerWord] |= (1UL << (idx % kSwAlarmTable_BitsPerWord));
+			++nexpect;
+		}
+	}
+
+	got = Cwsw_SwAlarmTable__Scan(&tbl, now);
+	++nscans;
+	if((got != nexpect) || memcmp(matured, expect, CWSW_ALARMTABLE_WORDS(n) * sizeof(matured[0])))
+	{
+		if(!nfaults)
+		{
+			fprintf(stderr, "check_table: %u alarms at tic %lld: %u matured, expected %u\n",
+				n, (long long)now, got, nexpect);
+		}
+		++nfaults;
+	}
+}
+
+/**	Fill a table of `n` alarms relative to `now`, and check one scan of it. */
+static void
+check_table(uint32_t n, tCwswClockTics now)
+{
+	uint32_t idx;
+
+	for(idx = 0; idx < n; ++idx)
+	{
+		(void)Cwsw_SwAlarm__Init(&alarms[idx], 0, 0, pDiscard, 1);
+		alarms[idx].tm = pick_deadline(now);
+		alarms[idx].tmrstate = (rand64() % 4) ? kTmrState_Enabled : kTmrState_Disabled;
+	}
+	(void)Cwsw_SwAlarmTable__Init(&tbl, deadlines, enabled, matured, alarms, n);
+	check_scan(n, now);
+}
+
+/**	Count a dispatch check's expectation, and say which failed. */
+static void
+check_that(bool ok, const char *name, const char *what)
+{
+	if(ok)	{ return; }
+	fprintf(stderr, "check_table: %s: %s\n", name, what);
+	++nfaults;
+}
+
+/**	Callback of every alarm in the dispatch checks: count the call, and act the first time. */
+static void
+cb_matured(struct sSwTimer *pAlarm, uint32_t evdata, void *pCtx)
+{
+	uint32_t idx = (uint32_t)(pAlarm - cbalarms);
+	pfCheckAction pfnAction = cbactions[idx];
+
+	(void)evdata;
+	(void)pCtx;
+	++cbcalls[idx];
+	cbactions[idx] = NULL;
+	if(pfnAction)	{ pfnAction(); }
+}
+
+/**	Set up the dispatch checks' table: one-shot alarms (or periodic, with `period`), all due on the
+ *	same tic.
+ */
+static void
+cb_setup(tCwswClockTics period)
+{
+	uint32_t idx;
+
+	for(idx = 0; idx < kCheck_CbAlarms; ++idx)
+	{
+		(void)Cwsw_SwAlarm__Init(&cbalarms[idx], 0, period, pDiscard, (int16_t)(1 + idx));
+		Cwsw_SwAlarm__SetCallback(&cbalarms[idx], cb_matured, NULL);
+		cbcalls[idx] = 0;
+		cbactions[idx] = NULL;
+	}
+	(void)Cwsw_SwAlarmTable__Init(&cbtbl, cbdeadlines, cbenabled, cbmatured, cbalarms, kCheck_CbAlarms);
+	for(idx = 0; idx < kCheck_CbAlarms; ++idx)	{ (void)Cwsw_SwAlarmTable__Arm(&cbtbl, idx, kCheck_CbDue); }
+}
+
+/**	Service the table one tic at a time until alarm `idx` has been called back `ncalls` times.
+ *	@returns Tics taken; kCheck_MaxTics if it never was.
+ */
+static uint32_t
+cb_run(uint32_t idx, uint32_t ncalls)
+{
+	uint32_t tics;
+
+	for(tics = 1; tics < kCheck_MaxTics; ++tics)
+	{
+		(void)Cwsw_ClockSvc__Task();
+		(void)Cwsw_SwAlarmTable__Task(&cbtbl);
+		if(cbcalls[idx] >= ncalls)	{ return tics; }
+	}
+	return kCheck_MaxTics;
+}
+
+static void
+act_disable1_rearm2(void)
+{
+	Cwsw_SwAlarmTable__Disable(&cbtbl, 1);
+	(void)Cwsw_SwAlarmTable__Arm(&cbtbl, 2, kCheck_CbRearm);
+}
+
+/**	Alarm 0's callback disables alarm 1 and re-arms alarm 2, all three due on the same tic. */
+static void
+check_cb_other(void)
+{
+	const char *name = "disable/arm another";
+
+	++ncases;
+	cb_setup(0);
+	cbactions[0] = act_disable1_rearm2;
+	check_that(cb_run(0, 1) == kCheck_CbDue, name, "alarm 0 not on time");
+	check_that(cbcalls[1] == 0, name, "disabled alarm matured");
+	check_that(cbalarms[1].tmrstate == kTmrState_Disabled, name, "disabled alarm not disabled");
+	check_that(cbcalls[2] == 0, name, "re-armed alarm matured at its old deadline");
+	check_that(cbalarms[2].tmrstate == kTmrState_Enabled, name, "re-armed alarm not enabled");
+	check_that(cbcalls[3] == 1, name, "untouched alarm didn't mature");
+	check_that(cb_run(2, 1) == kCheck_CbRearm, name, "re-armed alarm not at its new deadline");
+	check_that(cbcalls[1] == 0, name, "disabled alarm matured later");
+}
+
+static void
+act_pause0(void)
+{
+	Cwsw_SwAlarmTable__Pause(&cbtbl, 0);
+}
+
+static void
+act_pause2(void)
+{
+	Cwsw_SwAlarmTable__Pause(&cbtbl, 2);
+}
+
+/**	Service the table for `ntics` tics. */
+static void
+cb_idle(uint32_t ntics)
+{
+	while(ntics--)
+	{
+		(void)Cwsw_ClockSvc__Task();
+		(void)Cwsw_SwAlarmTable__Task(&cbtbl);
+	}
+}
+
+/**	A periodic alarm pauses itself from its callback; it keeps its next period's worth of time. */
+static void
+check_cb_pause_own(void)
+{
+	const char *name = "pause own";
+
+	++ncases;
+	cb_setup(kCheck_CbPeriod);
+	cbactions[0] = act_pause0;
+	check_that(cb_run(0, 1) == kCheck_CbDue, name, "alarm 0 not on time");
+	check_that(cbalarms[0].tmrstate == kTmrState_Paused, name, "not paused");
+	check_that(cbalarms[0].tm == kCheck_CbPeriod, name, "time left isn't the next period");
+
+	cb_idle(kCheck_CbPausedFor);
+	check_that(cbcalls[0] == 1, name, "matured while paused");
+	Cwsw_SwAlarmTable__Resume(&cbtbl, 0);
+	check_that(cb_run(0, 2) == kCheck_CbPeriod, name, "not a period after resuming");
+}
+
+/**	Alarm 0's callback pauses alarm 2, due on the same tic; alarm 2 keeps no time, so it matures as
+ *	soon as it is resumed.
+ */
+static void
+check_cb_pause_other(void)
+{
+	const char *name = "pause another";
+
+	++ncases;
+	cb_setup(kCheck_CbPeriod);
+	cbactions[0] = act_pause2;
+	check_that(cb_run(0, 1) == kCheck_CbDue, name, "alarm 0 not on time");
+	check_that(cbcalls[2] == 0, name, "paused alarm matured");
+	check_that(cbalarms[2].tmrstate == kTmrState_Paused, name, "not paused");
+	check_that(cbalarms[2].tm == 0, name, "time left isn't 0");
+	check_that(cbcalls[3] == 1, name, "untouched alarm didn't mature");
+
+	cb_idle(kCheck_CbPausedFor);
+	check_that(cbcalls[2] == 0, name, "matured while paused");
+	Cwsw_SwAlarmTable__Resume(&cbtbl, 2);
+	check_that(cb_run(2, 1) == 1, name, "not due on resuming");
+	check_that(cb_run(2, 2) == kCheck_CbPeriod, name, "not a period after that");
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+int
+main(void)
+{
+	uint32_t n;
+	uint32_t round;
+
+#if (CWSW_ALARMTABLE_SIMD) && defined(__AVX2__) && defined(__GNUC__)
+	if(!__builtin_cpu_supports("avx2"))
+	{
+		printf("{\"check\":\"table\",\"scan\":\"%s\",\"skipped\":true}\n", CHECK_SCAN);
+		return 0;
+	}
+#endif
+
+	pDiscard = Cwsw_StubEvQ__Init(&discard, NULL, 0);
+	for(n = 1; n <= kCheck_MaxAlarms; n += (n < 70) ? 1 : 23)
+	{
+		for(round = 0; round < kCheck_Rounds; ++round)	{ check_table(n, pick_now()); }
+	}
+
+	Cwsw_ClockSvc__Init(NULL, 0);
+	check_cb_other();
+	check_cb_pause_own();
+	check_cb_pause_other();
+
+	printf("{\"check\":\"table\",\"scan\":\"%s\",\"scans\":%llu,\"dispatch_cases\":%llu,\"faults\":%llu}\n",
+		CHECK_SCAN, (unsigned long long)nscans, (unsigned long long)ncases, (unsigned long long)nfaults);
+	return nfaults ? 1 : 0;
+}
@@ -0,0 +1,592 @@
+/** @file
+ *	@brief	CWSW SW Alarm Soak: randomized stress of SW alarms, checked against a reference model.
+ *
+ *	Description:
+ *	Each tic, the model first works out which alarms must mature and what each must post, exactly
+ *	as Cwsw_SwAlarm__Mature() documents it; then the engine services the alarms, and the alarms'
+ *	callbacks consume the expected events; then anything expected but not delivered, and any alarm
+ *	whose state or deadline has strayed from the model's, is a fault. An alarm found at fault is
+ *	cancelled, in the engine and the model alike, so one bug is not reported again on every tic.
+ *
+ *	One-shot alarms are disabled by their callback, as an application would; the polled path
+ *	otherwise leaves them enabled.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// ----	Project Headers -------------------------
+
+// ----	Module Headers --------------------------
+#include "cwsw_alarmsoak.h"
+
+#if (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_SIM)
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/**	Mix of operations, out of kSoakOp_Total. */
+enum eSoakOpMix {
+	kSoakOp_Arm		= 6,	//!< Arm afresh: new duration, period and rearm policy.
+	kSoakOp_Restart	= 4,	//!< Restart with a new duration, keeping period and policy.
+	kSoakOp_Cancel	= 3,
+	kSoakOp_Pause	= 3,
+	kSoakOp_Resume	= 4,
+	kSoakOp_Total	= kSoakOp_Arm + kSoakOp_Restart + kSoakOp_Cancel + kSoakOp_Pause + kSoakOp_Resume
+};
+
+/**	Wraparounds approached by successive warps. Visited in this order, each is less than half the
+ *	counter ahead of the last, so the clock only ever moves forward.
+ */
+enum eSoakWarp {
+	kSoakWarp_U32,		//!< Next rollover of the low 32 bits.
+	kSoakWarp_Sign,		//!< Sign change of the 64-bit tic.
+	kSoakWarp_Zero,		//!< Rollover of the 64-bit tic to 0.
+	kNumSoakWarps
+};
+
+static const char * const soak_engines[] = { "polled", "sched" };
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Global Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+static uint64_t
+soak_now_ns(void)
+{
+#if defined(__linux__)
+	struct timespec ts;
+
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+#else
+	return ((uint64_t)clock() * 1000000000ULL) / CLOCKS_PER_SEC;
+#endif
+}
+
+/**	Next pseudo-random number (xorshift64*). */
+static uint32_t
+soak_rand(ptCwswSwAlarmSoak pSoak)
+{
+	pSoak->rng ^= pSoak->rng >> 12;
+	pSoak->rng ^= pSoak->rng << 25;
+	pSoak->rng ^= pSoak->rng >> 27;
+	return (uint32_t)((pSoak->rng * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+/**	A random duration or period, 1..maxduration. */
+static tCwswClockTics
+soak_duration(ptCwswSwAlarmSoak pSoak)
+{
+	uint64_t r = ((uint64_t)soak_rand(pSoak) << 32) | soak_rand(pSoak);
+
+	return 1 + (tCwswClockTics)(r % (uint64_t)pSoak->cfg.maxduration);
+}
+
+/**	Record a fault against an alarm. */
+static void
+soak_fault(ptCwswSwAlarmSoak pSoak, tSwAlarmSoakFault kind, uint32_t idx)
+{
+	uint64_t total = 0;
+	int n;
+
+	for(n = 0; n < kNumSwAlarmSoakFaults; ++n)	{ total += pSoak->report.faults[n]; }
+	if(!total)
+	{
+		pSoak->report.firstfault = kind;
+		pSoak->report.firstalarm = idx;
+		pSoak->report.firsttic = Cwsw_ClockSvc__TimerTic();
+	}
+	++pSoak->report.faults[kind];
+}
+
+/**	Callback of every alarm: check the maturation against the model's expectation. */
+static void
+soak_matured(ptCwswSwAlarm pAlarm, uint32_t evdata, void *pCtx)
+{
+	ptCwswSwAlarmSoak pSoak = (ptCwswSwAlarmSoak)pCtx;
+	uint32_t idx = (uint32_t)(pAlarm - pSoak->pAlarms);
+	ptCwswSwAlarmSoakModel pModel = &pSoak->pModel[idx];
+
+	if(!pAlarm->reloadtm)	{ Cwsw_SwAlarm__SetState(pAlarm, kTmrState_Disabled); }
+
+	if(!pModel->expect)
+	{
+		soak_fault(pSoak, kSwAlarmSoakFault_Early, idx);
+		return;
+	}
+	if(evdata != pModel->data)	{ soak_fault(pSoak, kSwAlarmSoakFault_BadData, idx); }
+	pModel->data += pModel->step;
+	--pModel->expect;
+	++pSoak->report.events;
+}
+
+// ---- engine operations ---------------------------------------------------
+
+static void
+soak_start(ptCwswSwAlarmSoak pSoak, ptCwswSwAlarm pAlarm, tCwswClockTics duration)
+{
+	if(pSoak->cfg.engine == kSwAlarmSoak_Sched)
+	{
+		(void)Cwsw_SwAlarmSched__Arm(&pSoak->sched, pAlarm, duration);
+	}
+	else
+	{
+		// a paused alarm would take its new deadline for the time it has left.
+		Cwsw_SwAlarm__SetState(pAlarm, kTmrState_Disabled);
+		(void)Cwsw_ClockSvc__SetTimer(&pAlarm->tm, duration);
+		Cwsw_SwAlarm__SetState(pAlarm, kTmrState_Enabled);
+	}
+}
+
+static void
+soak_cancel(ptCwswSwAlarmSoak pSoak, ptCwswSwAlarm pAlarm)
+{
+	if(pSoak->cfg.engine == kSwAlarmSoak_Sched)	{ Cwsw_SwAlarmSched__Cancel(&pSoak->sched, pAlarm); }
+	else										{ Cwsw_SwAlarm__SetState(pAlarm, kTmrState_Disabled); }
+}
+
+static void
+soak_pause(ptCwswSwAlarmSoak pSoak, ptCwswSwAlarm pAlarm)
+{
+	if(pSoak->cfg.engine == kSwAlarmSoak_Sched)	{ Cwsw_SwAlarmSched__Pause(&pSoak->sched, pAlarm); }
+	else										{ Cwsw_SwAlarm__Pause(pAlarm); }
+}
+
+static void
+soak_resume(ptCwswSwAlarmSoak pSoak, ptCwswSwAlarm pAlarm)
+{
+	if(pSoak->cfg.engine == kSwAlarmSoak_Sched)	{ Cwsw_SwAlarmSched__Resume(&pSoak->sched, pAlarm); }
+	else										{ Cwsw_SwAlarm__Resume(pAlarm); }
+}
+
+/**	Service every alarm at the current tic. */
+static void
+soak_service(ptCwswSwAlarmSoak pSoak, tCwswClockTics now)
+{
+	uint32_t idx;
+
+	if(pSoak->cfg.engine == kSwAlarmSoak_Sched)
+	{
+		(void)Cwsw_SwAlarmSched__Advance(&pSoak->sched, now);
+		return;
+	}
+	for(idx = 0; idx < pSoak->nalarms; ++idx)	{ Cwsw_SwAlarm__ManageTimer(&pSoak->pAlarms[idx]); }
+}
+
+// ---- operations, on alarms and model alike -------------------------------
+
+/**	One random operation on one random alarm. */
+static void
+soak_op(ptCwswSwAlarmSoak pSoak)
+{
+	uint32_t idx = soak_rand(pSoak) % pSoak->nalarms;
+	uint32_t op = soak_rand(pSoak) % kSoakOp_Total;
+	ptCwswSwAlarm pAlarm = &pSoak->pAlarms[idx];
+	ptCwswSwAlarmSoakModel pModel = &pSoak->pModel[idx];
+	tCwswClockTics now = Cwsw_ClockSvc__TimerTic();
+	tCwswClockTics duration;
+
+	if(op < kSoakOp_Arm)
+	{
+		duration = soak_duration(pSoak);
+		pModel->reloadtm = (soak_rand(pSoak) % 5 < 2) ? 0 : soak_duration(pSoak);
+		pModel->rearm = (tSwAlarmRearm)(soak_rand(pSoak) % (kSwAlarmRearm_PostCount + 1));
+
+		soak_cancel(pSoak, pAlarm);
+		(void)Cwsw_SwAlarm__Init(pAlarm, 0, pModel->reloadtm, NULL, 0);
+		Cwsw_SwAlarm__SetRearmPolicy(pAlarm, pModel->rearm);
+		Cwsw_SwAlarm__SetCallback(pAlarm, soak_matured, pSoak);
+		soak_start(pSoak, pAlarm, duration);
+
+		pModel->tm = Cwsw_TicsAfter(now, duration);
+		pModel->state = kTmrState_Enabled;
+	}
+	else if((op -= kSoakOp_Arm) < kSoakOp_Restart)
+	{
+		duration = soak_duration(pSoak);
+		soak_start(pSoak, pAlarm, duration);
+
+		pModel->tm = Cwsw_TicsAfter(now, duration);
+		pModel->state = kTmrState_Enabled;
+	}
+	else if((op -= kSoakOp_Restart) < kSoakOp_Cancel)
+	{
+		soak_cancel(pSoak, pAlarm);
+		pModel->state = kTmrState_Disabled;
+	}
+	else if((op -= kSoakOp_Cancel) < kSoakOp_Pause)
+	{
+		soak_pause(pSoak, pAlarm);
+		if(pModel->state == kTmrState_Enabled)
+		{
+			pModel->tm = Cwsw_ElapsedTimeMs(now, pModel->tm);
+			pModel->state = kTmrState_Paused;
+		}
+	}
+	else
+	{
+		soak_resume(pSoak, pAlarm);
+		if(pModel->state == kTmrState_Paused)
+		{
+			pModel->tm = Cwsw_TicsAfter(now, pModel->tm);
+			pModel->state = kTmrState_Enabled;
+		}
+	}
+}
+
+/**	Tic on which the next warp lands. */
+static tCwswClockTics
+soak_warp_target(ptCwswSwAlarmSoak pSoak, tCwswClockTics now)
+{
+	uint64_t u32 = (((uint64_t)now + kSwAlarmSoak_WarpLead) | 0xFFFFFFFFULL) + 1;
+	uint64_t target;
+	uint64_t dist;
+
+	switch(pSoak->nextwarp)
+	{
+	case kSoakWarp_Sign:	target = (uint64_t)INT64_MAX + 1;	break;
+	case kSoakWarp_Zero:	target = 0;							break;
+	case kSoakWarp_U32:
+	default:				target = u32;						break;
+	}
+	pSoak->nextwarp = (pSoak->nextwarp + 1) % kNumSoakWarps;
+
+	// a wraparound more than half the counter ahead would look like the past; take the nearest.
+	dist = (target - kSwAlarmSoak_WarpLead) - (uint64_t)now;
+	if(!dist || (dist >= (1ULL << 63)))	{ target = u32; }
+	return (tCwswClockTics)(target - kSwAlarmSoak_WarpLead);
+}
+
+/**	Jump the clock to just short of a wraparound, with the alarms paused across the jump. */
+static void
+soak_warp(ptCwswSwAlarmSoak pSoak)
+{
+	tCwswClockTics now = Cwsw_ClockSvc__TimerTic();
+	tCwswClockTics target = soak_warp_target(pSoak, now);
+	ptCwswSwAlarmSoakModel pModel;
+	uint32_t idx;
+
+	for(idx = 0; idx < pSoak->nalarms; ++idx)
+	{
+		pModel = &pSoak->pModel[idx];
+		if(pModel->state != kTmrState_Enabled)	{ continue; }
+
+		soak_pause(pSoak, &pSoak->pAlarms[idx]);
+		pModel->tm = Cwsw_ElapsedTimeMs(now, pModel->tm);
+		pModel->state = kTmrState_Paused;
+		pModel->warped = true;
+	}
+
+	simclock = target;
+	(void)Cwsw_ClockSvc__Task();
+	soak_service(pSoak, target);	// nothing is armed; brings the scheduler up to the new tic
+
+	for(idx = 0; idx < pSoak->nalarms; ++idx)
+	{
+		pModel = &pSoak->pModel[idx];
+		if(!pModel->warped)		{ continue; }
+
+		soak_resume(pSoak, &pSoak->pAlarms[idx]);
+		pModel->tm = Cwsw_TicsAfter(target, pModel->tm);
+		pModel->state = kTmrState_Enabled;
+		pModel->warped = false;
+	}
+	++pSoak->report.warps;
+}
+
+/**	Work out which alarms must mature at `now`, what each must post, and where each rearms to. */
+static void
+soak_expect(ptCwswSwAlarmSoak pSoak, tCwswClockTics now)
+{
+	ptCwswSwAlarmSoakModel pModel;
+	tCwswClockTics late;
+	tCwswClockTics nperiods;
+	uint32_t idx;
+
+	for(idx = 0; idx < pSoak->nalarms; ++idx)
+	{
+		pModel = &pSoak->pModel[idx];
+		if(pModel->state != kTmrState_Enabled)	{ continue; }
+
+		late = Cwsw_ElapsedTimeMs(pModel->tm, now);
+		if(late < 0)	{ continue; }
+		if(late > pSoak->report.maxlate)	{ pSoak->report.maxlate = late; }
+
+		nperiods = 1;
+		if(pModel->reloadtm && (pModel->rearm != kSwAlarmRearm_FromService))
+		{
+			nperiods += late / pModel->reloadtm;
+		}
+
+		pModel->expect = 1;
+		pModel->data = TO_U32(pModel->tm);
+		pModel->step = 0;
+		switch(pModel->rearm)
+		{
+		case kSwAlarmRearm_PostEach:
+			pModel->expect = (uint32_t)nperiods;
+			pModel->step = TO_U32(pModel->reloadtm);
+			break;
+		case kSwAlarmRearm_PostCount:
+			pModel->data = (uint32_t)nperiods;
+			break;
+		default:
+			break;
+		}
+
+		if(!pModel->reloadtm)									{ pModel->state = kTmrState_Disabled; }
+		else if(pModel->rearm == kSwAlarmRearm_FromService)		{ pModel->tm = Cwsw_TicsAfter(now, pModel->reloadtm); }
+		else	{ pModel->tm = Cwsw_TicsAfter(pModel->tm, nperiods * pModel->reloadtm); }
+	}
+}
+
+/**	After servicing: every expected event delivered, and every alarm where the model has it. */
+static void
+soak_check(ptCwswSwAlarmSoak pSoak)
+{
+	ptCwswSwAlarmSoakModel pModel;
+	ptCwswSwAlarm pAlarm;
+	bool faulted;
+	uint32_t idx;
+
+	for(idx = 0; idx < pSoak->nalarms; ++idx)
+	{
+		pModel = &pSoak->pModel[idx];
+		pAlarm = &pSoak->pAlarms[idx];
+		faulted = false;
+
+		if(pModel->expect)
+		{
+			soak_fault(pSoak, kSwAlarmSoakFault_Missed, idx);
+			pModel->expect = 0;
+			faulted = true;
+		}
+		if((pAlarm->tmrstate != pModel->state)
+			|| ((pModel->state != kTmrState_Disabled) && (pAlarm->tm != pModel->tm)))
+		{
+			soak_fault(pSoak, kSwAlarmSoakFault_State, idx);
+			faulted = true;
+		}
+
+		if(faulted)
+		{
+			soak_cancel(pSoak, pAlarm);
+			pModel->state = kTmrState_Disabled;
+		}
+	}
+}
+
+/**	Advance the clock (by one tic, or by a stall, after a warp if one is due) and service the alarms. */
+static void
+soak_tic(ptCwswSwAlarmSoak pSoak)
+{
+	tCwswClockTics advance = 1;
+	tCwswClockTics now;
+	uint64_t startns;
+	uint64_t ns;
+
+	if(pSoak->cfg.warpevery && !--pSoak->ticstowarp)
+	{
+		soak_warp(pSoak);
+		pSoak->ticstowarp = pSoak->cfg.warpevery;
+	}
+
+	if((pSoak->cfg.maxstall > 1) && ((soak_rand(pSoak) % 1000) < pSoak->cfg.stallpermil))
+	{
+		advance = 2 + (tCwswClockTics)(soak_rand(pSoak) % (uint64_t)(pSoak->cfg.maxstall - 1));
+		++pSoak->report.stalls;
+	}
+
+	// the simulated clock reads, then increments; leave it where the task will read the new tic.
+	simclock = Cwsw_TicsAfter(Cwsw_ClockSvc__TimerTic(), advance);
+	(void)Cwsw_ClockSvc__Task();
+	now = Cwsw_ClockSvc__TimerTic();
+
+	soak_expect(pSoak, now);
+	startns = soak_now_ns();
+	soak_service(pSoak, now);
+	ns = soak_now_ns() - startns;
+	soak_check(pSoak);
+
+	pSoak->report.servicens += ns;
+	if(ns > pSoak->report.maxservicens)	{ pSoak->report.maxservicens = ns; }
+	CWSW_TICHIST_RECORD(pSoak->servicehist, ns);
+	++pSoak->report.tics;
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+/**	Set up a soak run.
+ *	Reinitializes the default clock domain, with no heartbeat queue, and starts it at `pCfg->start`;
+ *	every alarm starts out disabled.
+ *
+ *	@param [out]	pSoak		Run to initialize.
+ *	@param [in]		pCfg		Shape of the run; copied.
+ *	@param [out]	pAlarms		Alarms to exercise.
+ *	@param [out]	pModel		Storage for the model, one entry per alarm.
+ *	@param [in]		nalarms		Number of alarms.
+ *	@returns Error code, where 0 is no error.
+ */
+tErrorCodes_SwTmr
+Cwsw_SwAlarmSoak__Init(
+	ptCwswSwAlarmSoak			pSoak,
+	const tCwswSwAlarmSoakCfg	*pCfg,
+	ptCwswSwAlarm				pAlarms,
+	ptCwswSwAlarmSoakModel		pModel,
+	uint32_t					nalarms)
+{
+	uint32_t idx;
+
+	if(!pSoak || !pCfg || !pAlarms || !pModel || !nalarms)		{ return kErr_SwTmr_BadParm; }
+	if((pCfg->engine > kSwAlarmSoak_Sched) || !pCfg->maxopspertic)	{ return kErr_SwTmr_BadParm; }
+	if((pCfg->maxduration < 1) || (pCfg->maxstall < 0))			{ return kErr_SwTmr_BadParm; }
+
+	memset(pSoak, 0, sizeof(*pSoak));
+	pSoak->cfg = *pCfg;
+	pSoak->pAlarms = pAlarms;
+	pSoak->pModel = pModel;
+	pSoak->nalarms = nalarms;
+	pSoak->rng = pCfg->seed ^ 0x9E3779B97F4A7C15ULL;
+	if(!pSoak->rng)		{ pSoak->rng = 1; }
+	pSoak->ticstowarp = pCfg->warpevery;
+
+	Cwsw_ClockSvc__Init(NULL, 0);
+	simclock = pCfg->start;
+	(void)Cwsw_ClockSvc__Task();
+	(void)Cwsw_SwAlarmSched__Init(&pSoak->sched);
+
+	memset(pModel, 0, nalarms * sizeof(*pModel));
+	for(idx = 0; idx < nalarms; ++idx)
+	{
+		(void)Cwsw_SwAlarm__Init(&pAlarms[idx], 0, 0, NULL, 0);
+		Cwsw_SwAlarm__SetCallback(&pAlarms[idx], soak_matured, pSoak);
+		pModel[idx].state = kTmrState_Disabled;
+	}
+	return kErr_SwTmr_NoError;
+}
+
+
+/**	Run a number of random operations, with tics (and any stalls and warps) between them.
+ *	May be called repeatedly; the run picks up where it left off.
+ *
+ *	@returns Number of faults found during this call.
+ */
+uint64_t
+Cwsw_SwAlarmSoak__Run(ptCwswSwAlarmSoak pSoak, uint64_t nops)
+{
+	uint64_t before = 0;
+	uint64_t after = 0;
+	uint64_t startns;
+	uint32_t n;
+	int kind;
+
+	if(!pSoak || !pSoak->nalarms)	{ return 0; }
+
+	for(kind = 0; kind < kNumSwAlarmSoakFaults; ++kind)	{ before += pSoak->report.faults[kind]; }
+
+	while(nops)
+	{
+		n = soak_rand(pSoak) % (pSoak->cfg.maxopspertic + 1);
+		if(n > nops)	{ n = (uint32_t)nops; }
+
+		startns = soak_now_ns();
+		for(nops -= n, pSoak->report.ops += n; n; --n)	{ soak_op(pSoak); }
+		pSoak->report.opns += soak_now_ns() - startns;
+
+		soak_tic(pSoak);
+	}
+
+	for(kind = 0; kind < kNumSwAlarmSoakFaults; ++kind)	{ after += pSoak->report.faults[kind]; }
+	return after - before;
+}
+
+
+/**	Read the results of a run so far. */
+void
+Cwsw_SwAlarmSoak__GetReport(ptCwswSwAlarmSoak pSoak, ptCwswSwAlarmSoakReport pReport)
+{
+	if(!pSoak || !pReport)	{ return; }
+
+	*pReport = pSoak->report;
+#if (CWSW_CLOCK_HISTOGRAMS)
+	Cwsw_TicHist__Snapshot(&pSoak->servicehist, &pReport->service, false);
+#endif
+}
+
+
+/**	Format a run's results as one line of JSON (no trailing newline), for trend tracking alongside
+ *	the benchmark records of Cwsw_PerfCtr__Format():
+ *	`{"soak":"<name>","engine":"polled","alarms":N,"seed":N,"ops":N,"tics":N,"events":N,"stalls":N,
+ *	"warps":N,"faults":N,"early":N,"missed":N,"baddata":N,"state":N,"maxlate":N,"ns_per_op":X,
+ *	"ns_per_tic":X,"max_tic_ns":N}`; with histograms, also `"p99_tic_ns"` and `"p999_tic_ns"`.
+ *
+ *	@returns Length of the formatted line, as for snprintf().
+ */
+int
+Cwsw_SwAlarmSoak__Format(char *buf, size_t len, const char *name, const tCwswSwAlarmSoak *pSoak, const tCwswSwAlarmSoakReport *pReport)
+{
+	const uint64_t *pFaults;
+	int used;
+
+	if(!buf || !name || !pSoak || !pReport)	{ return -1; }
+
+	pFaults = pReport->faults;
+	used = snprintf(buf, len,
+		"{\"soak\":\"%s\",\"engine\":\"%s\",\"alarms\":%u,\"seed\":%llu,\"ops\":%llu,\"tics\":%llu,"
+		"\"events\":%llu,\"stalls\":%llu,\"warps\":%llu,\"faults\":%llu,\"early\":%llu,\"missed\":%llu,"
+		"\"baddata\":%llu,\"state\":%llu,\"maxlate\":%lld,\"ns_per_op\":%.3f,\"ns_per_tic\":%.3f,"
+		"\"max_tic_ns\":%llu",
+		name, soak_engines[pSoak->cfg.engine], pSoak->nalarms, (unsigned long long)pSoak->cfg.seed,
+		(unsigned long long)pReport->ops, (unsigned long long)pReport->tics,
+		(unsigned long long)pReport->events, (unsigned long long)pReport->stalls,
+		(unsigned long long)pReport->warps,
+		(unsigned long long)(pFaults[kSwAlarmSoakFault_Early] + pFaults[kSwAlarmSoakFault_Missed]
+			+ pFaults[kSwAlarmSoakFault_BadData] + pFaults[kSwAlarmSoakFault_State]),
+		(unsigned long long)pFaults[kSwAlarmSoakFault_Early], (unsigned long long)pFaults[kSwAlarmSoakFault_Missed],
+		(unsigned long long)pFaults[kSwAlarmSoakFault_BadData], (unsigned long long)pFaults[kSwAlarmSoakFault_State],
+		(long long)pReport->maxlate,
+		pReport->ops ? (double)pReport->opns / (double)pReport->ops : 0.0,
+		pReport->tics ? (double)pReport->servicens / (double)pReport->tics : 0.0,
+		(unsigned long long)pReport->maxservicens);
+	if((used < 0) || ((size_t)used >= len))	{ return used; }
+
+#if (CWSW_CLOCK_HISTOGRAMS)
+	return used + snprintf(buf + used, len - (size_t)used, ",\"p99_tic_ns\":%u,\"p999_tic_ns\":%u}",
+		pReport->service.p99, pReport->service.p999);
+#else
+	return used + snprintf(buf + used, len - (size_t)used, "}");
+#endif
+}
+
+#endif
@@ -0,0 +1,185 @@
+/** @file
+ *	@brief	CWSW SW Alarm Soak: randomized stress of SW alarms, checked against a reference model.
+ *
+ *	A soak run drives a set of alarms through a long, seeded, random sequence of operations (arm,
+ *	re-arm, cancel, pause, resume) on the simulated clock, servicing them between tics with the
+ *	chosen engine: the polled path (Cwsw_SwAlarm__ManageTimer()) or the alarm scheduler. A plain
+ *	model of every alarm predicts each maturation: on which tic, how many events and with what data.
+ *	Every callback is checked against the prediction, and after each tic every alarm's state and
+ *	deadline are checked against the model's.
+ *
+ *	To exercise the awkward cases, runs inject poll stalls (the clock jumps several tics between
+ *	services, so alarms mature late and periodic alarms overrun), and warp the clock to just short of
+ *	a counter wraparound: the 32-bit rollover of event data and wheel slots, the sign change of the
+ *	64-bit tic, and its rollover to 0. Alarms are paused across a warp, so the model and the alarms
+ *	stay in step.
+ *
+ *	A run takes over the default clock domain and `simclock`; available with the simulated clock
+ *	backend only. The same seed and configuration always produce the same sequence of operations.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+#ifndef CWSW_ALARMSOAK_H
+#define CWSW_ALARMSOAK_H
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_clock.h"			/* tCwswClockTics */
+
+// ----	Module Headers --------------------------
+#include "cwsw_alarmsched.h"	/* tCwswSwAlarmSched */
+
+
+#ifdef	__cplusplus
+extern "C" {
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+/**	How alarms are serviced each tic. */
+enum eSwAlarmSoakEngine {
+	kSwAlarmSoak_Polled,		//!< Cwsw_SwAlarm__ManageTimer() on every alarm.
+	kSwAlarmSoak_Sched			//!< Cwsw_SwAlarmSched__Advance() on a scheduler holding every alarm.
+};
+
+/**	Kinds of disagreement between the alarms and the model. */
+enum eSwAlarmSoakFault {
+	kSwAlarmSoakFault_Early,	//!< An alarm matured that the model did not expect to (early, extra, or not armed).
+	kSwAlarmSoakFault_Missed,	//!< An alarm the model expected to mature did not (or not as many times).
+	kSwAlarmSoakFault_BadData,	//!< An alarm matured with the wrong event data.
+	kSwAlarmSoakFault_State,	//!< After a tic, an alarm's state or deadline differed from the model's.
+	kNumSwAlarmSoakFaults
+};
+
+enum { kSwAlarmSoak_WarpLead = 4096 };	//!< Tics short of a wraparound that a warp lands on.
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+typedef enum eSwAlarmSoakEngine tSwAlarmSoakEngine;
+typedef enum eSwAlarmSoakFault tSwAlarmSoakFault;
+
+/**	Shape of a soak run. */
+typedef struct sCwswSwAlarmSoakCfg {
+	uint64_t			seed;			/**< Seed of the operation sequence; any value. */
+	tSwAlarmSoakEngine	engine;
+	tCwswClockTics		start;			/**< Tic the run starts on. */
+	uint32_t			maxopspertic;	/**< Most operations between two tics; each tic takes 0..max. */
+	tCwswClockTics		maxduration;	/**< Longest duration or period an alarm is armed with; at least 1. */
+	uint16_t			stallpermil;	/**< Chance per tic, in thousandths, of a poll stall. */
+	tCwswClockTics		maxstall;		/**< Longest stall, in tics; at least 2 if stalls are wanted. */
+	uint32_t			warpevery;		/**< Tics between warps to the next wraparound; 0 for none. */
+} tCwswSwAlarmSoakCfg, *ptCwswSwAlarmSoakCfg;
+
+/**	The model's view of one alarm. Storage only; the soak run owns it. */
+typedef struct sCwswSwAlarmSoakModel {
+	tSwTimerState		state;
+	tCwswClockTics		tm;			/**< Deadline; while paused, tics left, as the alarm's own `tm`. */
+	tCwswClockTics		reloadtm;
+	tSwAlarmRearm		rearm;
+	uint32_t			expect;		/**< Events still expected in the current service. */
+	uint32_t			data;		/**< Data of the next expected event. */
+	uint32_t			step;		/**< Difference in data between successive expected events. */
+	bool				warped;		/**< Paused by a warp, rather than by the run's operations. */
+} tCwswSwAlarmSoakModel, *ptCwswSwAlarmSoakModel;
+
+/**	Results of a soak run, cumulative since Cwsw_SwAlarmSoak__Init(). */
+typedef struct sCwswSwAlarmSoakReport {
+	uint64_t			ops;		/**< Operations performed. */
+	uint64_t			tics;		/**< Tics serviced. */
+	uint64_t			events;		/**< Maturation events checked. */
+	uint64_t			stalls;		/**< Poll stalls injected. */
+	uint64_t			warps;		/**< Warps to a wraparound. */
+	uint64_t			faults[kNumSwAlarmSoakFaults];
+	tCwswClockTics		maxlate;	/**< Most tics an alarm matured after its deadline (only stalls should cause any). */
+	uint64_t			opns;		/**< Time spent on operations, the model's bookkeeping included, in ns. */
+	uint64_t			servicens;	/**< Time spent servicing alarms, in ns. */
+	uint64_t			maxservicens;	/**< Longest service of one tic, in ns. */
+#if (CWSW_CLOCK_HISTOGRAMS)
+	tCwswTicHistSnapshot	service;	/**< Distribution of service time per tic, in ns. */
+#endif
+	// first fault, for a starting point; valid when any fault has been found.
+	tSwAlarmSoakFault	firstfault;
+	uint32_t			firstalarm;	/**< Index of the alarm concerned. */
+	tCwswClockTics		firsttic;
+} tCwswSwAlarmSoakReport, *ptCwswSwAlarmSoakReport;
+
+/**	A soak run. */
+typedef struct sCwswSwAlarmSoak {
+	tCwswSwAlarmSoakCfg		cfg;
+	ptCwswSwAlarm			pAlarms;
+	ptCwswSwAlarmSoakModel	pModel;
+	uint32_t				nalarms;
+	tCwswSwAlarmSched		sched;		/**< Used by kSwAlarmSoak_Sched. */
+	uint64_t				rng;
+	uint32_t				ticstowarp;
+	uint32_t				nextwarp;	/**< Which wraparound the next warp approaches. */
+	tCwswSwAlarmSoakReport	report;
+#if (CWSW_CLOCK_HISTOGRAMS)
+	tCwswTicHist			servicehist;
+#endif
+} tCwswSwAlarmSoak, *ptCwswSwAlarmSoak;
+
+
+// ============================================================================
+// ----	Public Variables ------------------------------------------------------
+// ============================================================================
+
+// ============================================================================
+// ----	Public API ------------------------------------------------------------
+// ============================================================================
+
+#if (CWSW_CLOCK_BACKEND == CWSW_CLOCK_BACKEND_SIM)
+
+// ---- Discrete Functions -------------------------------------------------- {
+
+extern tErrorCodes_SwTmr Cwsw_SwAlarmSoak__Init(
+	ptCwswSwAlarmSoak			pSoak,
+	const tCwswSwAlarmSoakCfg	*pCfg,
+	ptCwswSwAlarm				pAlarms,
+	ptCwswSwAlarmSoakModel		pModel,
+	uint32_t					nalarms);
+extern uint64_t Cwsw_SwAlarmSoak__Run(ptCwswSwAlarmSoak pSoak, uint64_t nops);
+extern void Cwsw_SwAlarmSoak__GetReport(ptCwswSwAlarmSoak pSoak, ptCwswSwAlarmSoakReport pReport);
+extern int Cwsw_SwAlarmSoak__Format(char *buf, size_t len, const char *name, const tCwswSwAlarmSoak *pSoak, const tCwswSwAlarmSoakReport *pReport);
+
+// ---- /Discrete Functions ------------------------------------------------- }
+
+#endif
+
+// ---- Targets for Get/Set APIs -------------------------------------------- {
+
+/** "Chapter Designator" for Get/Set API.
+ *	Intentionally unused symbol, designed to get you to the correct starting
+ *	point, when you want to find macros for the Get/Set API; simply highlight
+ *	the Module argument in your IDE (e.g, Eclipse, NetBeans, etc.), and select
+ *	Go To Definition.
+ */
+enum { Cwsw_SwAlarmSoak };	/* Component ID for SW Alarm Soak */
+
+// ---- /Targets for Get/Set APIs ------------------------------------------- }
+
+
+#ifdef	__cplusplus
+}
+#endif
+
+#endif /* CWSW_ALARMSOAK_H */
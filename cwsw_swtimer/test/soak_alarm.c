@@ -0,0 +1,115 @@
+/** @file
+ *	@brief	Check: soak SW alarms against the reference model of cwsw_alarmsoak.h.
+ *
+ *	Runs the polled path and the alarm scheduler through the same kinds of run:
+ *	- `steady`: from tic 0, with poll stalls;
+ *	- `wrap`: from just short of the sign change of the tic, with poll stalls, warping the clock to
+ *	  the next wraparound every few thousand tics.
+ *
+ *	Each run performs the number of operations given on the command line (2M by default) over 512
+ *	alarms, and prints its report as one line of JSON (see Cwsw_SwAlarmSoak__Format()). Exits nonzero
+ *	if any run finds a fault, after saying where the first one was.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <stdio.h>
+#include <stdlib.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_clock.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_alarmsoak.h"
+
+#if (CWSW_CLOCK_BACKEND != CWSW_CLOCK_BACKEND_SIM)
+#error "The alarm soak runs on the simulated clock."
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum {
+	kSoak_Alarms		= 512,
+	kSoak_DefaultOps	= 2000000
+};
+
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+static tCwswSwAlarm alarms[kSoak_Alarms];
+static tCwswSwAlarmSoakModel model[kSoak_Alarms];
+static tCwswSwAlarmSoak soak;
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/**	Do one run, and report it.
+ *	@returns Number of faults found.
+ */
+static uint64_t
+soak_run(const char *name, const tCwswSwAlarmSoakCfg *pCfg, uint64_t nops)
+{
+	tCwswSwAlarmSoakReport report;
+	char line[512];
+	uint64_t faults;
+
+	if(Cwsw_SwAlarmSoak__Init(&soak, pCfg, alarms, model, kSoak_Alarms))
+	{
+		fprintf(stderr, "soak_alarm: %s: bad configuration\n", name);
+		return 1;
+	}
+	faults = Cwsw_SwAlarmSoak__Run(&soak, nops);
+	Cwsw_SwAlarmSoak__GetReport(&soak, &report);
+	(void)Cwsw_SwAlarmSoak__Format(line, sizeof(line), name, &soak, &report);
+	puts(line);
+
+	if(faults)
+	{
+		fprintf(stderr, "soak_alarm: %s: first fault of kind %d, on alarm %u at tic %lld\n",
+			name, (int)report.firstfault, report.firstalarm, (long long)report.firsttic);
+	}
+	return faults;
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+int
+main(int argc, char *argv[])
+{
+	static const tSwAlarmSoakEngine engines[] = { kSwAlarmSoak_Polled, kSwAlarmSoak_Sched };
+	uint64_t nops = (argc > 1) ? strtoull(argv[1], NULL, 0) : kSoak_DefaultOps;
+	tCwswSwAlarmSoakCfg cfg;
+	uint64_t faults = 0;
+	uint32_t e;
+
+	for(e = 0; e < sizeof(engines) / sizeof(engines[0]); ++e)
+	{
+		cfg = (tCwswSwAlarmSoakCfg){ .seed = 42 + e, .engine = engines[e], .start = 0, .maxopspertic = 8,
+			.maxduration = 300, .stallpermil = 20, .maxstall = 50, .warpevery = 0 };
+		faults += soak_run("steady", &cfg, nops);
+
+		cfg.start = INT64_MAX - 100;
+		cfg.warpevery = 5000;
+		faults += soak_run("wrap", &cfg, nops);
+	}
+	return faults ? 1 : 0;
+}
@@ -0,0 +1,360 @@
+/** @file
+ *	@brief	Trace tool: record clock and alarm activity on several threads, and write it out as JSON.
+ *
+ *	The main thread runs the clock (monotonic backend) for a short while; each worker thread runs
+ *	an alarm scheduler of its own, posting to a stub queue it drains only now and then, so that the
+ *	trace holds tics, armed, fired, late and cancelled alarms, and posts that succeed and fail.
+ *	Every thread records on its own ring. Afterwards, the rings are written as Chrome trace-event
+ *	JSON (Cwsw_Trace__WriteJson()) to the file named on the command line, `trace.json` by default,
+ *	which opens in `chrome://tracing` and the Perfetto UI.
+ *
+ *	The file is then read back and checked to be well-formed JSON. Prints the cost of one record
+ *	(see Cwsw_PerfCtr__Format()) and one line of JSON describing the trace; exits nonzero if the
+ *	output is malformed, or any ring is missing from it.
+ *
+ *	\copyright
+ *	Copyright (c) 2020 Kevin L. Becker. All rights reserved.
+ *
+ *	Created on: Oct 17, 2026
+ *	@author Kevin L. Becker
+ */
+
+// ============================================================================
+// ----	Include Files ---------------------------------------------------------
+// ============================================================================
+
+// ----	System Headers --------------------------
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ----	Project Headers -------------------------
+#include "cwsw_clock.h"
+#include "cwsw_trace.h"
+#include "cwsw_perfctr.h"
+#include "stub_evqueue.h"
+
+// ----	Module Headers --------------------------
+#include "cwsw_swtimer.h"
+#include "cwsw_alarmsched.h"
+
+#if !(CWSW_CLOCK_TRACE) || !(CWSW_CLOCK_MULTICORE) || (CWSW_CLOCK_BACKEND != CWSW_CLOCK_BACKEND_MONOTONIC)
+#error "The trace tool needs CWSW_CLOCK_TRACE, CWSW_CLOCK_MULTICORE and the monotonic clock backend."
+#endif
+
+
+// ============================================================================
+// ----	Constants -------------------------------------------------------------
+// ============================================================================
+
+enum {
+	kTrace_Workers		= 2,			//!< Alarm threads.
+	kTrace_Alarms		= 16,			//!< Alarms per thread.
+	kTrace_QueueDepth	= 8,			//!< Events each thread's queue holds.
+	kTrace_DrainTics	= 4,			//!< Tics between drains of a thread's queue.
+	kTrace_RunNs		= 50000000,		//!< How long the clock runs.
+	kTrace_Records		= 4096,			//!< Records per ring; a power of 2.
+	kTrace_CostRecords	= 64,			//!< Records in the ring used to time recording.
+	kTrace_RecordOps	= 1000000		//!< Records made to time one.
+};
+
+
+// ============================================================================
+// ----	Type Definitions ------------------------------------------------------
+// ============================================================================
+
+/**	One alarm thread. */
+typedef struct sTraceWorker {
+	pthread_t			thread;
+	char				name[16];
+	tCwswTraceRing		ring;
+	tCwswTraceRec		recs[kTrace_Records];
+	tCwswSwAlarmSched	sched;
+	tCwswSwAlarm		alarms[kTrace_Alarms];
+	tStubEvQ			queue;
+	tEvQ_Event			events[kTrace_QueueDepth];
+} tTraceWorker;
+
+/**	Position in the JSON being checked. */
+typedef struct sTraceJson {
+	const char	*p;
+	const char	*end;
+	uint32_t	nevents;		/**< Objects seen in the `traceEvents` array. */
+	uint32_t	depth;
+} tTraceJson;
+
+
+// ============================================================================
+// ----	Module-level Variables ------------------------------------------------
+// ============================================================================
+
+static tTraceWorker workers[kTrace_Workers];
+static tCwswTraceRing mainring;
+static tCwswTraceRec mainrecs[kTrace_Records];
+static tCwswTraceRing costring;
+static tCwswTraceRec costrecs[kTrace_CostRecords];
+static tCwswTraceRec scratch[kTrace_Records];
+static atomic_bool stop;
+
+
+// ============================================================================
+// ----	Private Functions -----------------------------------------------------
+// ============================================================================
+
+/**	Alarm thread: arm every alarm, then service them until told to stop. One alarm is cancelled and
+ *	re-armed whenever the queue is drained.
+ */
+static void *
+trace_worker(void *pArg)
+{
+	tTraceWorker *pWorker = (tTraceWorker *)pArg;
+	ptEvQ_QueueCtrlEx pQueue;
+	tCwswClockTics lasttic = 0;
+	tCwswClockTics now;
+	tEvQ_Event ev;
+	uint32_t ntics = 0;
+	uint32_t i;
+
+	(void)Cwsw_Trace__Attach(&pWorker->ring, pWorker->recs, kTrace_Records, pWorker->name);
+	pQueue = Cwsw_StubEvQ__Init(&pWorker->queue, pWorker->events, kTrace_QueueDepth);
+	(void)Cwsw_SwAlarmSched__Init(&pWorker->sched);
+	for(i = 0; i < kTrace_Alarms; ++i)
+	{
+		(void)Cwsw_SwAlarm__Init(&pWorker->alarms[i], 0, 1 + (i % 8), pQueue, (int16_t)(1 + i));
+		(void)Cwsw_SwAlarmSched__Arm(&pWorker->sched, &pWorker->alarms[i], 1 + (i % 8));
+	}
+
+	while(!atomic_load(&stop))
+	{
+		(void)Cwsw_SwAlarmSched__Task(&pWorker->sched);
+
+		now = Cwsw_ClockSvc__TimerTic();
+		if(now == lasttic)			{ continue; }
+		lasttic = now;
+		if(++ntics % kTrace_DrainTics)	{ continue; }
+
+		while(Cwsw_StubEvQ__Get(&pWorker->queue, &ev))	{ }
+		i = ntics % kTrace_Alarms;
+		Cwsw_SwAlarmSched__Cancel(&pWorker->sched, &pWorker->alarms[i]);
+		(void)Cwsw_SwAlarmSched__Arm(&pWorker->sched, &pWorker->alarms[i], 1 + (i % 8));
+	}
+	Cwsw_Trace__Detach();
+	return NULL;
+}
+
+/**	Time one record, on a small ring of its own so the records made don't crowd out the clock's. */
+static void
+trace_cost(void)
+{
+	tCwswPerfCtr ctr;
+	tCwswPerfSample sample;
+	char line[256];
+	uint32_t i;
+
+	(void)Cwsw_Trace__Attach(&costring, costrecs, kTrace_CostRecords, "record cost");
+	(void)Cwsw_PerfCtr__Open(&ctr);
+	Cwsw_PerfCtr__Start(&ctr);
+	for(i = 0; i < kTrace_RecordOps; ++i)	{ CWSW_TRACE(kCwswTrace_User, 0, i); }
+	Cwsw_PerfCtr__Stop(&ctr, &sample, kTrace_RecordOps);
+	Cwsw_PerfCtr__Close(&ctr);
+
+	(void)Cwsw_PerfCtr__Format(line, sizeof(line), "Trace/record", 1, &sample);
+	puts(line);
+}
+
+/**	@name Minimal JSON checker.
+ *	Just enough of a recursive-descent parser to say whether the text is one well-formed value.
+ *	Each returns false at the first error.
+ */
+//! @{
+static bool json_value(tTraceJson *pJs);
+
+static void
+json_space(tTraceJson *pJs)
+{
+	while((pJs->p < pJs->end) && *pJs->p && strchr(" \t\r\n", *pJs->p))	{ ++pJs->p; }
+}
+
+static bool
+json_literal(tTraceJson *pJs, const char *lit)
+{
+	size_t len = strlen(lit);
+
+	if(((size_t)(pJs->end - pJs->p) < len) || memcmp(pJs->p, lit, len))	{ return false; }
+	pJs->p += len;
+	return true;
+}
+
+static bool
+json_string(tTraceJson *pJs)
+{
+	if(!json_literal(pJs, "\""))	{ return false; }
+	for(; pJs->p < pJs->end; ++pJs->p)
+	{
+		if(*pJs->p == '"')					{ ++pJs->p; return true; }
+		if((unsigned char)*pJs->p < ' ')	{ return false; }
+		if((*pJs->p == '\\') && (++pJs->p >= pJs->end))	{ return false; }
+	}
+	return false;
+}
+
+static bool
+json_number(tTraceJson *pJs)
+{
+	const char *start = pJs->p;
+
+	if((pJs->p < pJs->end) && (*pJs->p == '-'))	{ ++pJs->p; }
+	while((pJs->p < pJs->end) && *pJs->p && strchr("0123456789.eE+-", *pJs->p))	{ ++pJs->p; }
+	return pJs->p > start;
+}
+
+static bool
+json_members(tTraceJson *pJs, char close, bool keyed)
+{
+	json_space(pJs);
+	if((pJs->p < pJs->end) && (*pJs->p == close))	{ ++pJs->p; return true; }
+	for(;;)
+	{
+		if(keyed)
+		{
+			json_space(pJs);
+			if(!json_string(pJs))	{ return false; }
+			json_space(pJs);
+			if(!json_literal(pJs, ":"))	{ return false; }
+		}
+		if(!json_value(pJs))	{ return false; }
+		json_space(pJs);
+		if(pJs->p >= pJs->end)	{ return false; }
+		if(*pJs->p == close)	{ ++pJs->p; return true; }
+		if(*pJs->p++ != ',')	{ return false; }
+	}
+}
+
+static bool
+json_value(tTraceJson *pJs)
+{
+	bool ok;
+
+	json_space(pJs);
+	if(pJs->p >= pJs->end)	{ return false; }
+	switch(*pJs->p)
+	{
+	case '{':
+		// the trace's events are the objects two levels down: {"traceEvents":[{...}, ...]}
+		if(pJs->depth == 2)	{ ++pJs->nevents; }
+		++pJs->p;
+		++pJs->depth;
+		ok = json_members(pJs, '}', true);
+		--pJs->depth;
+		return ok;
+	case '[':
+		++pJs->p;
+		++pJs->depth;
+		ok = json_members(pJs, ']', false);
+		--pJs->depth;
+		return ok;
+	case '"':
+		return json_string(pJs);
+	case 't':
+		return json_literal(pJs, "true");
+	case 'f':
+		return json_literal(pJs, "false");
+	case 'n':
+		return json_literal(pJs, "null");
+	default:
+		return json_number(pJs);
+	}
+}
+//! @}
+
+/**	Read back the trace, and check it.
+ *	@returns Number of trace events in the file; -1 if it can't be read or isn't well-formed.
+ */
+static long
+trace_check(const char *path, const char *pThread)
+{
+	tTraceJson js = { NULL, NULL, 0, 0 };
+	char *pText;
+	FILE *fp = fopen(path, "rb");
+	long len;
+	long nevents = -1;
+
+	if(!fp)		{ return -1; }
+	(void)fseek(fp, 0, SEEK_END);
+	len = ftell(fp);
+	(void)fseek(fp, 0, SEEK_SET);
+	pText = (len > 0) ? malloc((size_t)len) : NULL;
+	if(pText && (fread(pText, 1, (size_t)len, fp) == (size_t)len))
+	{
+		js.p = pText;
+		js.end = pText + len;
+		if(json_value(&js))
+		{
+			json_space(&js);
+			if(js.p == js.end)	{ nevents = (long)js.nevents; }
+		}
+		// every ring names its thread.
+		if(pThread && !memmem(pText, (size_t)len, pThread, strlen(pThread)))	{ nevents = -1; }
+	}
+	free(pText);
+	(void)fclose(fp);
+	return nevents;
+}
+
+
+// ============================================================================
+// ----	Public Functions ------------------------------------------------------
+// ============================================================================
+
+int
+main(int argc, char *argv[])
+{
+	const char *path = (argc > 1) ? argv[1] : "trace.json";
+	FILE *fp;
+	uint64_t start;
+	long nevents;
+	int nrecs;
+	bool valid;
+	uint32_t w;
+
+	trace_cost();
+	Cwsw_ClockSvc__Init(NULL, 0);
+	(void)Cwsw_Trace__Attach(&mainring, mainrecs, kTrace_Records, "clock");
+	(void)Cwsw_ClockSvc__Task();	// the workers arm their alarms from the first tic
+
+	for(w = 0; w < kTrace_Workers; ++w)
+	{
+		(void)snprintf(workers[w].name, sizeof(workers[w].name), "alarms %u", w + 1);
+		if(pthread_create(&workers[w].thread, NULL, trace_worker, &workers[w]))	{ return 1; }
+	}
+	start = Cwsw_PerfCtr__NowNs();
+	while(Cwsw_PerfCtr__NowNs() - start < kTrace_RunNs)	{ (void)Cwsw_ClockSvc__Task(); }
+	atomic_store(&stop, true);
+	for(w = 0; w < kTrace_Workers; ++w)	{ (void)pthread_join(workers[w].thread, NULL); }
+
+	fp = fopen(path, "w");
+	if(!fp)
+	{
+		fprintf(stderr, "trace_alarm: can't write %s\n", path);
+		return 1;
+	}
+	nrecs = Cwsw_Trace__WriteJson(fp, scratch, kTrace_Records);
+	if(fclose(fp))	{ nrecs = -1; }
+
+	nevents = trace_check(path, "\"clock\"");
+	for(w = 0; (nevents >= 0) && (w < kTrace_Workers); ++w)
+	{
+		char thread[24];
+
+		(void)snprintf(thread, sizeof(thread), "\"%s\"", workers[w].name);
+		nevents = trace_check(path, thread);
+	}
+
+	// besides the records, the file names the process and each ring's thread.
+	valid = (nrecs > 0) && (nevents == nrecs + 1 + (2 + kTrace_Workers));
+	printf("{\"check\":\"trace\",\"file\":\"%s\",\"records\":%d,\"events\":%ld,\"valid\":%s}\n",
+		path, nrecs, nevents, valid ? "true" : "false");
+	return valid ? 0 : 1;
+}